@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "floaxie/atof.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	vector<string> generate(const char* format, size_t count)
+	{
+		mt19937_64 gen(1);
+		uniform_real_distribution<double> dis(-1, 1);
+
+		vector<string> ret;
+		char buffer[128];
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			snprintf(buffer, sizeof(buffer), format, dis(gen) * pow(10, int(gen() % 20) - 10));
+			ret.push_back(buffer);
+		}
+
+		return ret;
+	}
+
+	// nanoseconds per value of the fastest pass parsing the values in ranges
+	double measure(const vector<string>& values, double& sink)
+	{
+		double best(HUGE_VAL);
+
+		for (size_t pass = 0; pass < 50; ++pass)
+		{
+			const auto start(chrono::steady_clock::now());
+
+			for (const auto& str : values)
+			{
+				char* str_end;
+				sink += atof<double>(str.data(), str.data() + str.size(), &str_end).value;
+			}
+
+			const chrono::duration<double, nano> elapsed(chrono::steady_clock::now() - start);
+			best = min(best, elapsed.count() / values.size());
+		}
+
+		return best;
+	}
+}
+
+int main(int, char**)
+{
+	// compare the results of `atof_profile` and `atof_profile_simd`
+	cout << (simd_digit_scan<char> ? "SIMD" : "portable") << " scan of digit runs" << endl;
+
+	const char* const formats[] = { "%.17g", "%.6f", "%.3e", "%.0f", "%.40f" };
+	double sink(0);
+
+	for (auto format : formats)
+		cout << format << ": " << measure(generate(format, 10000), sink) << " ns" << endl;
+
+	return sink != sink;
+}
@@ -18,10 +18,19 @@
 #define FLOAXIE_ATOF_H
 
 #include <string>
+#include <array>
+#include <algorithm>
+#include <cstddef>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 #include <floaxie/krosh.h>
 
 #include <floaxie/default_fallback.h>
+#include <floaxie/exact_fallback.h>
+#include <floaxie/value_and_status.h>
 
 #include <floaxie/conversion_status.h>
 
@@ -33,24 +42,80 @@
  */
 namespace floaxie
 {
-	/** \brief Small decorator around returning value to help the client
-	 * optionally receive minor error states along with it.
+	/** \brief Returns status of conversion made by fallback function, which
+	 * returns bare value (like `strtod()` does).
 	 *
-	 * \tparam FloatType target floating point type to store results.
+	 * \sa `check_errno()`
 	 */
-	template<typename FloatType> struct value_and_status
+	template<typename FloatType> inline conversion_status fallback_status(FloatType value)
 	{
-		/** \brief The returning result value itself. */
-		FloatType value;
-		/** \brief Conversion status indicating any problems occurred. */
-		conversion_status status;
+		return check_errno(value);
+	}
 
-		/** \brief Constructs the object with empty value and successful status. */
-		value_and_status() noexcept : value(), status(conversion_status::success) { }
-		/** \brief Default conversion operator to `FloatType` to make use of the
-		 * wrapper more transparent. */
-		operator FloatType() const noexcept { return value; }
-	};
+	/** \brief Returns status of conversion made by fallback function, which
+	 * returns `value_and_status`.
+	 */
+	template<typename FloatType> inline conversion_status fallback_status(const value_and_status<FloatType>& result) noexcept
+	{
+		return result.status;
+	}
+
+	/** \brief Fallback policy of `atof()`, which never calls any fallback
+	 * conversion.
+	 *
+	 * If **Krosh** is unsure, if the result is correctly rounded, the
+	 * result of `diy_fp::downsample()` is returned as is, with
+	 * `conversion_status::inexact` status. Such results may differ from the
+	 * correctly rounded ones by one unit in the last place, but the time of
+	 * the conversion doesn't depend on the input as much, as with slow exact
+	 * fallback or `strtod()` (and `errno` is never checked).
+	 *
+	 * Example: `atof<double>(str, &str_end, no_fallback())`.
+	 */
+	struct no_fallback { };
+
+	/** \brief Returns the result of **Krosh** with no fallback conversion.
+	 *
+	 * \sa `no_fallback`
+	 */
+	template<typename FloatType, typename CharType> inline value_and_status<FloatType> approximate_result(const krosh_result<FloatType, CharType>& cr) noexcept
+	{
+		value_and_status<FloatType> result;
+		result.value = cr.value;
+		result.status = cr.is_accurate ? cr.status : conversion_status::inexact;
+
+		return result;
+	}
+
+	/** \brief Checks, if the fallback function is `exact_fallback()`.
+	 *
+	 * Callables of other types are never `exact_fallback()`.
+	 */
+	template<typename FloatType, typename CharType, typename FallbackCallable> constexpr bool is_exact_fallback(const FallbackCallable&) noexcept
+	{
+		return false;
+	}
+
+	/** \brief Checks, if the fallback function pointer points to
+	 * `exact_fallback()`.
+	 *
+	 * If it does, the result of **Krosh** can be passed to `exact_refine()`
+	 * right away instead of parsing the input once again.
+	 */
+	template<typename FloatType, typename CharType> inline bool is_exact_fallback(value_and_status<FloatType> (*fallback_func)(const CharType*, CharType**)) noexcept
+	{
+		return fallback_func == &exact_fallback<FloatType, CharType>;
+	}
+
+#if __cpp_noexcept_function_type
+	/** \brief `is_exact_fallback()` overload for pointers to `noexcept`
+	 * functions (e.g. `exact_fallback()` passed explicitly since C++17).
+	 */
+	template<typename FloatType, typename CharType> inline bool is_exact_fallback(value_and_status<FloatType> (*fallback_func)(const CharType*, CharType**) noexcept) noexcept
+	{
+		return fallback_func == &exact_fallback<FloatType, CharType>;
+	}
+#endif
 
 	/** \brief Parses floating point string representation.
 	 *
@@ -72,17 +137,19 @@ namespace floaxie
 	 * \tparam CharType character type (typically `char` or `wchar_t`) the input
 	 * string \p **str** consists of.
 	 * \tparam FallbackCallable fallback conversion function type, in case of
-	 * Krosh is unsure if the result is correctly rounded (default is `strtof()`
-	 * for `float`'s, `strtod()` for `double`'s, `strtold()` for `long double`'s).
+	 * Krosh is unsure if the result is correctly rounded (default is
+	 * `exact_fallback()`).
 	 *
 	 * \param str buffer containing the string representation of the value.
 	 * \param str_end out parameter, which will contain a pointer to first
 	 * character after the parsed value in the specified buffer. If str_end is
 	 * null, it is ignored.
 	 * \param fallback_func pointer to fallback function. If omitted, by default
-	 * is `strtof()` for `float`'s, `strtod()` for `double`'s, `strtold()` for
-	 * `long double`'s. Null value will lead to undefined behaviour in case of
-	 * algorithm is unsure and fall back to using it.
+	 * is `exact_fallback()`. It may return either bare value (like `strtod()`
+	 * does, then conversion status is taken from `errno`) or
+	 * `value_and_status`. Null value will lead to undefined behaviour in case
+	 * of algorithm is unsure and fall back to using it. `no_fallback` policy
+	 * may be passed instead to get approximate result in such cases.
 	 *
 	 * \return structure containing the parsed value, if the
 	 * input is correct (default constructed value otherwise) and status of the
@@ -95,9 +162,9 @@ namespace floaxie
 	<
 		typename FloatType,
 		typename CharType,
-		typename FallbackCallable = FloatType (const CharType*, CharType**)
+		typename FallbackCallable = value_and_status<FloatType> (const CharType*, CharType**)
 	>
-	inline value_and_status<FloatType> atof(const CharType* str, CharType** str_end, FallbackCallable fallback_func = default_fallback<FloatType, CharType>)
+	inline value_and_status<FloatType> atof(const CharType* str, CharType** str_end, FallbackCallable fallback_func = exact_fallback<FloatType, CharType>)
 	{
 		value_and_status<FloatType> result;
 
@@ -110,10 +177,15 @@ namespace floaxie
 				result.value = cr.value;
 				result.status = cr.status;
 			}
+			else if (is_exact_fallback<FloatType, CharType>(fallback_func))
+			{
+				result = exact_refine(str, cr);
+			}
 			else
 			{
-				result.value = fallback_func(str, str_end);
-				result.status = check_errno(result.value);
+				const auto& fr(fallback_func(str, str_end));
+				result.value = fr;
+				result.status = fallback_status(fr);
 
 				return result;
 			}
@@ -132,11 +204,295 @@ namespace floaxie
 	<
 		typename FloatType,
 		typename CharType,
-		typename FallbackCallable = FloatType (const CharType*, CharType**)
+		typename FallbackCallable = value_and_status<FloatType> (const CharType*, CharType**)
 		>
-	inline value_and_status<FloatType> atof(const CharType* str, std::nullptr_t str_end, FallbackCallable fallback_func = default_fallback<FloatType, CharType>)
+	inline value_and_status<FloatType> atof(const CharType* str, std::nullptr_t str_end, FallbackCallable fallback_func = exact_fallback<FloatType, CharType>)
 	{
-		return atof<FloatType, CharType, FallbackCallable>(str, static_cast<CharType**>(str_end), fallback_func);
+		return atof<FloatType>(str, static_cast<CharType**>(str_end), fallback_func);
+	}
+
+	/** \brief `atof()` overload with `no_fallback` policy.
+	 *
+	 * \sa `no_fallback`
+	 */
+	template<typename FloatType, typename CharType>
+	inline value_and_status<FloatType> atof(const CharType* str, CharType** str_end, no_fallback) noexcept
+	{
+		value_and_status<FloatType> result;
+
+		const auto& cr(krosh<FloatType>(str));
+
+		if (cr.str_end != str)
+			result = approximate_result(cr);
+
+		if (str_end)
+			*str_end = const_cast<CharType*>(cr.str_end);
+
+		return result;
+	}
+
+	/** \brief Size of on-stack buffer `atof()` copies bounded input to
+	 * before passing it to the fallback function.
+	 *
+	 * Longer representations are copied to dynamically allocated buffer.
+	 */
+	constexpr std::size_t fallback_buffer_size(64);
+
+	/** \brief Parses floating point string representation, stored in the
+	 * range, which is not necessarily null-terminated.
+	 *
+	 * The same as the one above, but no character at or after \p **last** is
+	 * ever read, so that values can be parsed right from memory-mapped files,
+	 * network buffers etc.
+	 *
+	 * Fallback functions (like `strtod()`) expect null-terminated strings, so
+	 * the parsed part of the range is copied to temporary null-terminated
+	 * buffer before the fallback function is called with it. The default
+	 * `exact_fallback()` needs no copy, as the result of **Krosh** is passed
+	 * to `exact_refine()` directly.
+	 *
+	 * \tparam FloatType target floating point type to store results.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) the input
+	 * range consists of.
+	 * \tparam FallbackCallable fallback conversion function type, in case of
+	 * Krosh is unsure if the result is correctly rounded (default is
+	 * `exact_fallback()`).
+	 *
+	 * \param first pointer to the beginning of the range containing the string
+	 * representation of the value.
+	 * \param last pointer to the end of the range.
+	 * \param str_end out parameter, which will contain a pointer to first
+	 * character after the parsed value in the specified range. If str_end is
+	 * null, it is ignored.
+	 * \param fallback_func pointer to fallback function. If omitted, by default
+	 * is `exact_fallback()`. It may return either bare value (like `strtod()`
+	 * does, then conversion status is taken from `errno`) or
+	 * `value_and_status`. Null value will lead to undefined behaviour in case
+	 * of algorithm is unsure and fall back to using it. `no_fallback` policy
+	 * may be passed instead to get approximate result in such cases.
+	 *
+	 * \return structure containing the parsed value, if the
+	 * input is correct (default constructed value otherwise) and status of the
+	 * conversion made.
+	 *
+	 * \sa `value_and_status`
+	 * \sa `conversion_status`
+	 */
+	template
+	<
+		typename FloatType,
+		typename CharType,
+		typename FallbackCallable = value_and_status<FloatType> (const CharType*, CharType**)
+	>
+	inline value_and_status<FloatType> atof(const CharType* first, const CharType* last, CharType** str_end, FallbackCallable fallback_func = exact_fallback<FloatType, CharType>)
+	{
+		value_and_status<FloatType> result;
+
+		// empty range may be represented by two null pointers, which
+		// mean null-terminated string for Krosh
+		if (first == last)
+		{
+			if (str_end)
+				*str_end = const_cast<CharType*>(first);
+
+			return result;
+		}
+
+		const auto& cr(krosh<FloatType>(first, last));
+
+		if (cr.str_end != first)
+		{
+			if (cr.is_accurate)
+			{
+				result.value = cr.value;
+				result.status = cr.status;
+			}
+			else if (is_exact_fallback<FloatType, CharType>(fallback_func))
+			{
+				result = exact_refine(first, cr);
+			}
+			else
+			{
+				const std::size_t length(cr.str_end - first);
+
+				std::array<CharType, fallback_buffer_size> stack_buffer;
+				std::basic_string<CharType> heap_buffer;
+
+				CharType* buffer;
+				if (length < fallback_buffer_size)
+				{
+					buffer = stack_buffer.data();
+				}
+				else
+				{
+					heap_buffer.resize(length + 1);
+					buffer = &heap_buffer[0];
+				}
+
+				std::copy(first, cr.str_end, buffer);
+				buffer[length] = CharType();
+
+				CharType* buffer_end;
+				const auto& fr(fallback_func(buffer, &buffer_end));
+				result.value = fr;
+				result.status = fallback_status(fr);
+
+				if (str_end)
+					*str_end = const_cast<CharType*>(first) + (buffer_end - buffer);
+
+				return result;
+			}
+		}
+
+		if (str_end)
+			*str_end = const_cast<CharType*>(cr.str_end);
+
+		return result;
+	}
+
+	/** \brief Tiny overload for bounded `atof()` function to allow passing
+	 * `nullptr` as `str_end` parameter.
+	 */
+	template
+	<
+		typename FloatType,
+		typename CharType,
+		typename FallbackCallable = value_and_status<FloatType> (const CharType*, CharType**)
+	>
+	inline value_and_status<FloatType> atof(const CharType* first, const CharType* last, std::nullptr_t str_end, FallbackCallable fallback_func = exact_fallback<FloatType, CharType>)
+	{
+		return atof<FloatType>(first, last, static_cast<CharType**>(str_end), fallback_func);
+	}
+
+	/** \brief Bounded `atof()` overload with `no_fallback` policy.
+	 *
+	 * No temporary buffer is ever needed, as no fallback function is called.
+	 *
+	 * \sa `no_fallback`
+	 */
+	template<typename FloatType, typename CharType>
+	inline value_and_status<FloatType> atof(const CharType* first, const CharType* last, CharType** str_end, no_fallback) noexcept
+	{
+		value_and_status<FloatType> result;
+
+		// empty range may be represented by two null pointers, which
+		// mean null-terminated string for Krosh
+		if (first == last)
+		{
+			if (str_end)
+				*str_end = const_cast<CharType*>(first);
+
+			return result;
+		}
+
+		const auto& cr(krosh<FloatType>(first, last));
+
+		if (cr.str_end != first)
+			result = approximate_result(cr);
+
+		if (str_end)
+			*str_end = const_cast<CharType*>(cr.str_end);
+
+		return result;
+	}
+
+	/** \brief Return structure for `atof_many()`.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * parsed range.
+	 */
+	template<typename CharType> struct atof_many_result
+	{
+		/** \brief Number of values parsed and stored. */
+		std::size_t count;
+		/** \brief Pointer to the first character, which is not parsed. */
+		const CharType* str_end;
+	};
+
+	/** \brief Checks, if the character is one of the separators.
+	 *
+	 * \param c character to check.
+	 * \param separators null-terminated string of separator characters.
+	 */
+	template<typename CharType> inline bool is_separator(CharType c, const CharType* separators) noexcept
+	{
+		for (; *separators; ++separators)
+		{
+			if (c == *separators)
+				return true;
+		}
+
+		return false;
+	}
+
+	/** \brief Parses list of floating point values, separated by the
+	 * specified characters, to an array.
+	 *
+	 * Values in the range are parsed one by one by **Krosh** algorithm and
+	 * stored to the array, until the end of the range, the first malformed
+	 * value or the first value, which is not followed by one of the
+	 * separators, is met, or the array is full. The results **Krosh** is
+	 * unsure about are refined by `exact_refine()`, so all of them are
+	 * correctly rounded, and no memory is allocated.
+	 *
+	 * \tparam FloatType target floating point type to store results.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) the input
+	 * range consists of.
+	 *
+	 * \param first pointer to the beginning of the range to parse.
+	 * \param last pointer to the end of the range.
+	 * \param separators null-terminated string of characters, any of which
+	 * can separate the values (e.g. ",;").
+	 * \param values array to store the parsed values to.
+	 * \param statuses array to store conversion statuses of each of the
+	 * parsed values to or `nullptr`, if they are not needed.
+	 * \param capacity size of \p **values** (and \p **statuses**) array.
+	 *
+	 * \return `atof_many_result` structure with number of parsed values and
+	 * pointer to the character, where the parsing stopped (which is \p
+	 * **last**, if the whole range is parsed).
+	 *
+	 * \sa `conversion_status`
+	 */
+	template<typename FloatType, typename CharType>
+	inline atof_many_result<CharType> atof_many(const CharType* first, const CharType* last, const CharType* separators,
+		FloatType* values, conversion_status* statuses, std::size_t capacity) noexcept
+	{
+		atof_many_result<CharType> ret { 0, first };
+
+		while (ret.count < capacity && first != last)
+		{
+			const auto& cr(krosh<FloatType>(first, last));
+
+			if (cr.str_end == first)
+				break;
+
+			if (cr.is_accurate)
+			{
+				values[ret.count] = cr.value;
+
+				if (statuses)
+					statuses[ret.count] = cr.status;
+			}
+			else
+			{
+				const auto& result(exact_refine(first, cr));
+				values[ret.count] = result.value;
+
+				if (statuses)
+					statuses[ret.count] = result.status;
+			}
+
+			++ret.count;
+			ret.str_end = first = cr.str_end;
+
+			if (first == last || !is_separator(*first, separators))
+				break;
+
+			ret.str_end = ++first;
+		}
+
+		return ret;
 	}
 
 	/** \brief Parses floating point represented in `std::basic_string`.
@@ -148,14 +504,16 @@ namespace floaxie
 	 * \tparam CharType character type (typically `char` or `wchar_t`) the input
 	 * string \p **str** consists of.
 	 * \tparam FallbackCallable fallback conversion function type, in case of
-	 * Krosh is unsure if the result is correctly rounded (default is `strtof()`
-	 * for `float`'s, `strtod()` for `double`'s, `strtold()` for `long double`'s).
+	 * Krosh is unsure if the result is correctly rounded (default is
+	 * `exact_fallback()`).
 	 *
 	 * \param str string representation of the value.
 	 * \param fallback_func pointer to fallback function. If omitted, by default
-	 * is `strtof()` for `float`'s, `strtod()` for `double`'s, `strtold()` for
-	 * `long double`'s. Null value will lead to undefined behaviour in case of
-	 * algorithm is unsure and fall back to using it.
+	 * is `exact_fallback()`. It may return either bare value (like `strtod()`
+	 * does, then conversion status is taken from `errno`) or
+	 * `value_and_status`. Null value will lead to undefined behaviour in case
+	 * of algorithm is unsure and fall back to using it. `no_fallback` policy
+	 * may be passed instead to get approximate result in such cases.
 	 *
 	 * \return structure containing the parsed value, if the
 	 * input is correct (default constructed value otherwise) and status of the
@@ -168,12 +526,53 @@ namespace floaxie
 	<
 		typename FloatType,
 		typename CharType,
-		typename FallbackCallable = FloatType (const CharType*, CharType**)
+		typename FallbackCallable = value_and_status<FloatType> (const CharType*, CharType**)
 	>
-	inline value_and_status<FloatType> from_string(const std::basic_string<CharType>& str, FallbackCallable fallback_func = default_fallback<FloatType, CharType>)
+	inline value_and_status<FloatType> from_string(const std::basic_string<CharType>& str, FallbackCallable fallback_func = exact_fallback<FloatType, CharType>)
 	{
 		return atof<FloatType>(str.c_str(), nullptr, fallback_func);
 	}
+
+#if __cplusplus >= 201703L
+	/** \brief Parses floating point represented in `std::basic_string_view`.
+	 *
+	 * `atof()` adapter for `std::basic_string_view` strings. The string view
+	 * isn't required to be null-terminated, as no character outside of it is
+	 * ever read.
+	 *
+	 * \tparam FloatType target floating point type to store results.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) the input
+	 * string \p **str** consists of.
+	 * \tparam FallbackCallable fallback conversion function type, in case of
+	 * Krosh is unsure if the result is correctly rounded (default is
+	 * `exact_fallback()`).
+	 *
+	 * \param str string view of the value representation.
+	 * \param fallback_func pointer to fallback function. If omitted, by default
+	 * is `exact_fallback()`. It may return either bare value (like `strtod()`
+	 * does, then conversion status is taken from `errno`) or
+	 * `value_and_status`. Null value will lead to undefined behaviour in case
+	 * of algorithm is unsure and fall back to using it. `no_fallback` policy
+	 * may be passed instead to get approximate result in such cases.
+	 *
+	 * \return structure containing the parsed value, if the
+	 * input is correct (default constructed value otherwise) and status of the
+	 * conversion made.
+	 *
+	 * \sa `value_and_status`
+	 * \sa `conversion_status`
+	 */
+	template
+	<
+		typename FloatType,
+		typename CharType,
+		typename FallbackCallable = value_and_status<FloatType> (const CharType*, CharType**)
+	>
+	inline value_and_status<FloatType> from_string(std::basic_string_view<CharType> str, FallbackCallable fallback_func = exact_fallback<FloatType, CharType>)
+	{
+		return atof<FloatType>(str.data(), str.data() + str.size(), nullptr, fallback_func);
+	}
+#endif
 }
 
 #endif // FLOAXIE_ATOF_H
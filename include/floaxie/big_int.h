@@ -0,0 +1,225 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_BIG_INT_H
+#define FLOAXIE_BIG_INT_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace floaxie
+{
+	/** \brief Capacity of `big_int` in limbs.
+	 *
+	 * 4096 bits are enough to hold any intermediate value of exact
+	 * conversions of `double` values.
+	 */
+	constexpr std::size_t big_int_capacity(128);
+
+	/** \brief Unsigned integer of arbitrary (but limited) precision.
+	 *
+	 * Minimal set of operations needed to compare decimal and binary
+	 * representations of floating point values exactly. The value is stored
+	 * in fixed size array of 32-bit limbs (least significant limb first), so
+	 * no dynamic memory is ever allocated.
+	 *
+	 * Exceeding the capacity leads to undefined behaviour.
+	 */
+	class big_int
+	{
+	public:
+		/** \brief Type of one limb of the value. */
+		typedef std::uint32_t limb_type;
+
+		/** \brief Type, which can hold a product of two limbs. */
+		typedef std::uint64_t wide_limb_type;
+
+		/** \brief Constructs zero value. */
+		big_int() noexcept : m_size(0) { }
+
+		/** \brief Constructs the value from native integer. */
+		explicit big_int(std::uint64_t value) noexcept : m_size(0)
+		{
+			while (value)
+			{
+				m_limbs[m_size++] = limb_type(value);
+				value >>= limb_bits;
+			}
+		}
+
+		/** \brief Checks if the value is zero. */
+		bool is_zero() const noexcept
+		{
+			return !m_size;
+		}
+
+		/** \brief Multiplies the value by \p **factor** and adds \p **addend**
+		 * to the product.
+		 */
+		void multiply_add(limb_type factor, limb_type addend) noexcept
+		{
+			wide_limb_type carry(addend);
+
+			for (std::size_t i = 0; i < m_size; ++i)
+			{
+				carry += wide_limb_type(m_limbs[i]) * factor;
+				m_limbs[i] = limb_type(carry);
+				carry >>= limb_bits;
+			}
+
+			push_carry(limb_type(carry));
+		}
+
+		/** \brief Multiplies the value by 5 in the specified power. */
+		void multiply_pow5(unsigned int power) noexcept
+		{
+			// the biggest power of 5 fitting one limb
+			constexpr unsigned int max_limb_power(13);
+			constexpr limb_type max_limb_pow5(1220703125);
+
+			for (; power >= max_limb_power; power -= max_limb_power)
+				multiply_add(max_limb_pow5, 0);
+
+			limb_type factor(1);
+			while (power--)
+				factor *= 5;
+
+			multiply_add(factor, 0);
+		}
+
+		/** \brief Multiplies the value by 2 in the specified power. */
+		void shift_left(unsigned int power) noexcept
+		{
+			if (!m_size || !power)
+				return;
+
+			const std::size_t limb_shift(power / limb_bits);
+			const unsigned int bit_shift(power % limb_bits);
+
+			if (bit_shift)
+			{
+				limb_type carry(0);
+				for (std::size_t i = 0; i < m_size; ++i)
+				{
+					const limb_type l(m_limbs[i]);
+					m_limbs[i] = (l << bit_shift) | carry;
+					carry = l >> (limb_bits - bit_shift);
+				}
+
+				push_carry(carry);
+			}
+
+			if (limb_shift)
+			{
+				assert(m_size + limb_shift <= big_int_capacity);
+
+				for (std::size_t i = m_size; i-- > 0;)
+					m_limbs[i + limb_shift] = m_limbs[i];
+
+				for (std::size_t i = 0; i < limb_shift; ++i)
+					m_limbs[i] = 0;
+
+				m_size += limb_shift;
+			}
+		}
+
+		/** \brief Multiplies the value by 10 in the specified power. */
+		void multiply_pow10(unsigned int power) noexcept
+		{
+			multiply_pow5(power);
+			shift_left(power);
+		}
+
+		/** \brief Adds \p **rhs** to the value. */
+		void add(const big_int& rhs) noexcept
+		{
+			wide_limb_type carry(0);
+
+			for (std::size_t i = 0; i < rhs.m_size || (carry && i < m_size); ++i)
+			{
+				if (i == m_size)
+					m_limbs[m_size++] = 0;
+
+				carry += wide_limb_type(m_limbs[i]) + (i < rhs.m_size ? rhs.m_limbs[i] : 0);
+				m_limbs[i] = limb_type(carry);
+				carry >>= limb_bits;
+			}
+
+			push_carry(limb_type(carry));
+		}
+
+		/** \brief Subtracts \p **rhs** from the value.
+		 *
+		 * If \p **rhs** is greater, than the value, the behaviour is undefined.
+		 */
+		void subtract(const big_int& rhs) noexcept
+		{
+			assert(compare(*this, rhs) >= 0);
+
+			limb_type borrow(0);
+
+			for (std::size_t i = 0; i < rhs.m_size || (borrow && i < m_size); ++i)
+			{
+				const wide_limb_type subtrahend(wide_limb_type(i < rhs.m_size ? rhs.m_limbs[i] : 0) + borrow);
+				borrow = m_limbs[i] < subtrahend;
+				m_limbs[i] = limb_type(m_limbs[i] - subtrahend);
+			}
+
+			while (m_size && !m_limbs[m_size - 1])
+				--m_size;
+		}
+
+		/** \brief Compares two values.
+		 *
+		 * \return negative value, if \p **lhs** is less, than \p **rhs**,
+		 * zero, if they are equal, positive value otherwise.
+		 */
+		friend int compare(const big_int& lhs, const big_int& rhs) noexcept
+		{
+			if (lhs.m_size != rhs.m_size)
+				return lhs.m_size < rhs.m_size ? -1 : 1;
+
+			for (std::size_t i = lhs.m_size; i-- > 0;)
+			{
+				if (lhs.m_limbs[i] != rhs.m_limbs[i])
+					return lhs.m_limbs[i] < rhs.m_limbs[i] ? -1 : 1;
+			}
+
+			return 0;
+		}
+
+	private:
+		/** \brief Number of bits in one limb. */
+		static constexpr unsigned int limb_bits = 32;
+
+		/** \brief Appends new most significant limb, if it's not zero. */
+		void push_carry(limb_type carry) noexcept
+		{
+			if (carry)
+			{
+				assert(m_size < big_int_capacity);
+				m_limbs[m_size++] = carry;
+			}
+		}
+
+		std::array<limb_type, big_int_capacity> m_limbs;
+		std::size_t m_size;
+	};
+}
+
+#endif // FLOAXIE_BIG_INT_H
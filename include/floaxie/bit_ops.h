@@ -27,8 +27,15 @@
 #include <limits>
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cassert>
 
+#if __cplusplus > 201703L && defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
 #include <floaxie/integer_of_size.h>
 
 namespace floaxie
@@ -134,6 +141,129 @@ namespace floaxie
 		return nth_bit(value, bit_size<NumericType>() - 1);
 	}
 
+	/** \brief Counts leading (left most) zero bits of the specified value
+	 * by binary search.
+	 *
+	 * Portable version of `count_leading_zeros()`. The behaviour is
+	 * undefined for zero value.
+	 *
+	 * \tparam NumericType unsigned integer type of the value.
+	 *
+	 * \param value the value to count leading zero bits of.
+	 *
+	 * \return number of leading zero bits.
+	 */
+	template<typename NumericType> constexpr int portable_count_leading_zeros(NumericType value) noexcept
+	{
+		int ret(0);
+
+		for (std::size_t half = bit_size<NumericType>() / 2; half; half /= 2)
+		{
+			if (!(value >> (bit_size<NumericType>() - half)))
+			{
+				value <<= half;
+				ret += int(half);
+			}
+		}
+
+		return ret;
+	}
+
+	/** \brief Counts leading (left most) zero bits of the specified value.
+	 *
+	 * Uses `std::countl_zero()` of C++20 or compiler built-ins, where
+	 * available (unless `FLOAXIE_NO_INTRINSICS` is defined), falling back to
+	 * `portable_count_leading_zeros()` otherwise. The behaviour is undefined
+	 * for zero value.
+	 *
+	 * \param value the value to count leading zero bits of.
+	 *
+	 * \return number of leading zero bits.
+	 */
+	constexpr int count_leading_zeros(std::uint64_t value) noexcept
+	{
+#if defined(__cpp_lib_bitops)
+		return std::countl_zero(value);
+#elif !defined(FLOAXIE_NO_INTRINSICS) && (defined(__GNUC__) || defined(__clang__))
+		return __builtin_clzll(value);
+#else
+		return portable_count_leading_zeros(value);
+#endif
+	}
+
+	/** \brief `count_leading_zeros()` overload for 32-bit values. */
+	constexpr int count_leading_zeros(std::uint32_t value) noexcept
+	{
+#if defined(__cpp_lib_bitops)
+		return std::countl_zero(value);
+#elif !defined(FLOAXIE_NO_INTRINSICS) && (defined(__GNUC__) || defined(__clang__))
+		return __builtin_clz(value);
+#else
+		return portable_count_leading_zeros(value);
+#endif
+	}
+
+	/** \brief Counts trailing (right most) zero bits of the specified value.
+	 *
+	 * Portable version of `count_trailing_zeros()`. The behaviour is
+	 * undefined for zero value.
+	 *
+	 * \tparam NumericType unsigned integer type of the value.
+	 *
+	 * \param value the value to count trailing zero bits of.
+	 *
+	 * \return number of trailing zero bits.
+	 */
+	template<typename NumericType> constexpr int portable_count_trailing_zeros(NumericType value) noexcept
+	{
+		int ret(0);
+
+		for (std::size_t half = bit_size<NumericType>() / 2; half; half /= 2)
+		{
+			if (!(value << (bit_size<NumericType>() - half)))
+			{
+				value >>= half;
+				ret += int(half);
+			}
+		}
+
+		return ret;
+	}
+
+	/** \brief Counts trailing (right most) zero bits of the specified value.
+	 *
+	 * Uses `std::countr_zero()` of C++20 or compiler built-ins, where
+	 * available (unless `FLOAXIE_NO_INTRINSICS` is defined), falling back to
+	 * `portable_count_trailing_zeros()` otherwise. The behaviour is undefined
+	 * for zero value.
+	 *
+	 * \param value the value to count trailing zero bits of.
+	 *
+	 * \return number of trailing zero bits.
+	 */
+	constexpr int count_trailing_zeros(std::uint64_t value) noexcept
+	{
+#if defined(__cpp_lib_bitops)
+		return std::countr_zero(value);
+#elif !defined(FLOAXIE_NO_INTRINSICS) && (defined(__GNUC__) || defined(__clang__))
+		return __builtin_ctzll(value);
+#else
+		return portable_count_trailing_zeros(value);
+#endif
+	}
+
+	/** \brief `count_trailing_zeros()` overload for 32-bit values. */
+	constexpr int count_trailing_zeros(std::uint32_t value) noexcept
+	{
+#if defined(__cpp_lib_bitops)
+		return std::countr_zero(value);
+#elif !defined(FLOAXIE_NO_INTRINSICS) && (defined(__GNUC__) || defined(__clang__))
+		return __builtin_ctz(value);
+#else
+		return portable_count_trailing_zeros(value);
+#endif
+	}
+
 	/** \brief Returns mask of \p **n** bits from the right.
 	 *
 	 * \tparam NumericType type of the returned value.
@@ -189,10 +319,13 @@ namespace floaxie
 	 * target position (which rounding is being performed to). According to the
 	 * algorithm math it should be greater, than zero, otherwise behaviour is
 	 * undefined.
+	 * \param error maximum absolute error of \p **last_bits** value. If the
+	 * exact value may lay on the other side of (or right in) the middle, the
+	 * rounding is considered inaccurate.
 	 *
 	 * \returns `round_result` structure with the rounding decision.
 	 */
-	template<typename NumericType> inline round_result round_up(NumericType last_bits, std::size_t round_to_power) noexcept
+	template<typename NumericType> inline round_result round_up(NumericType last_bits, std::size_t round_to_power, NumericType error = 0) noexcept
 	{
 		round_result ret;
 
@@ -200,7 +333,8 @@ namespace floaxie
 
 		const NumericType round_bit(raised_bit<NumericType>(round_to_power - 1));
 		const NumericType check_mask(mask<NumericType>(round_to_power + 1) ^ round_bit);
-		ret.is_accurate = (last_bits & mask<NumericType>(round_to_power)) != round_bit;
+		const NumericType rest(last_bits & mask<NumericType>(round_to_power));
+		ret.is_accurate = (rest > round_bit ? rest - round_bit : round_bit - rest) > error;
 		ret.value = (last_bits & round_bit) && (last_bits & check_mask);
 
 		return ret;
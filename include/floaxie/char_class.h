@@ -0,0 +1,116 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_CHAR_CLASS_H
+#define FLOAXIE_CHAR_CLASS_H
+
+#include <type_traits>
+#include <cstddef>
+
+namespace floaxie
+{
+	/** \brief Classes of characters, which `parse_digits()` distinguishes. */
+	enum class char_class : unsigned char
+	{
+		/** \brief '0' character. */
+		zero,
+
+		/** \brief Digits from '1' to '9'. */
+		digit,
+
+		/** \brief Decimal point. */
+		dot,
+
+		/** \brief '+' or '-' characters. */
+		sign,
+
+		/** \brief First character of NaN representation ('n' or 'N'). */
+		nan,
+
+		/** \brief First character of infinity representation ('i' or 'I'). */
+		inf,
+
+		/** \brief Any other character, which ends the value. */
+		other
+	};
+
+	/** \brief Number of entries in `char_classes` table. */
+	constexpr std::size_t char_class_table_size(256);
+
+	/** \brief Wrapper of the table of character classes to be returned by
+	 * value from `constexpr` function.
+	 */
+	struct char_class_table
+	{
+		/** \brief Classes of the characters. */
+		char_class classes[char_class_table_size];
+	};
+
+	/** \brief Fills the table of character classes in compile time. */
+	constexpr char_class_table make_char_class_table() noexcept
+	{
+		char_class_table ret { };
+
+		for (std::size_t c = 0; c < char_class_table_size; ++c)
+		{
+			if (c == '0')
+				ret.classes[c] = char_class::zero;
+			else if (c >= '1' && c <= '9')
+				ret.classes[c] = char_class::digit;
+			else if (c == '.')
+				ret.classes[c] = char_class::dot;
+			else if (c == '+' || c == '-')
+				ret.classes[c] = char_class::sign;
+			else if (c == 'n' || c == 'N')
+				ret.classes[c] = char_class::nan;
+			else if (c == 'i' || c == 'I')
+				ret.classes[c] = char_class::inf;
+			else
+				ret.classes[c] = char_class::other;
+		}
+
+		return ret;
+	}
+
+	/** \brief LUT of character classes indexed by code of the character. */
+	constexpr char_class_table char_classes = make_char_class_table();
+
+	/** \brief Returns the class of the character.
+	 *
+	 * Characters of the types wider, than `char` (e.g. `wchar_t` or
+	 * `char16_t`), are looked up in `char_classes` after range check.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`).
+	 *
+	 * \param c the character to classify.
+	 *
+	 * \return `char_class` of the character.
+	 */
+	template<typename CharType> constexpr char_class classify_char(CharType c) noexcept
+	{
+		typedef typename std::make_unsigned<CharType>::type code_type;
+
+		return static_cast<code_type>(c) < char_class_table_size ? char_classes.classes[static_cast<code_type>(c)] : char_class::other;
+	}
+
+	/** \brief `char` version of `classify_char()`, which needs no range check. */
+	constexpr char_class classify_char(char c) noexcept
+	{
+		return char_classes.classes[static_cast<unsigned char>(c)];
+	}
+}
+
+#endif // FLOAXIE_CHAR_CLASS_H
@@ -0,0 +1,503 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_CHARCONV_H
+#define FLOAXIE_CHARCONV_H
+
+#include <system_error>
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#define FLOAXIE_HAS_STD_CHARS_FORMAT
+#endif
+#endif
+
+#include <floaxie/krosh.h>
+#include <floaxie/exact_fallback.h>
+#include <floaxie/ftoa.h>
+#include <floaxie/precision.h>
+#include <floaxie/chars_format.h>
+#include <floaxie/conversion_status.h>
+
+namespace floaxie
+{
+	/** \brief Return structure for `from_chars()`, the same as
+	 * `std::from_chars_result` of C++17, but for any character type.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of
+	 * the parsed range.
+	 */
+	template<typename CharType> struct basic_from_chars_result
+	{
+		/** \brief Pointer to the first character after the parsed value. */
+		const CharType* ptr;
+		/** \brief Error code of the conversion or value initialized
+		 * `std::errc` in case of success.
+		 */
+		std::errc ec;
+	};
+
+	/** \brief `basic_from_chars_result` for `char` ranges. */
+	typedef basic_from_chars_result<char> from_chars_result;
+
+	/** \brief Converts conversion status to error code of
+	 * `std::from_chars()` semantics.
+	 */
+	inline std::errc to_errc(conversion_status status) noexcept
+	{
+		return status == conversion_status::success ? std::errc() : std::errc::result_out_of_range;
+	}
+
+	/** \brief Checks, if the representation starts with a digit or a decimal
+	 * point (after optional minus sign), i.e. it's not NaN or infinity.
+	 */
+	template<typename CharType> inline bool is_numeric(const CharType* first, const CharType* last) noexcept
+	{
+		if (first != last && *first == '-')
+			++first;
+
+		return first != last && ((*first >= '0' && *first <= '9') || *first == '.');
+	}
+
+	/** \brief Parses floating point string representation with semantics of
+	 * `std::from_chars()`.
+	 *
+	 * Interprets the representation in the range using **Krosh** algorithm,
+	 * refining the result by `exact_refine()`, if it's not ensured to be
+	 * rounded correctly. In contrast to `atof()`, the function doesn't accept
+	 * plus sign before the value and the presence of exponent part is
+	 * controlled by \p **fmt**. Just like `std::from_chars()`, it doesn't
+	 * throw, depend on current locale or allocate memory.
+	 *
+	 * \tparam FloatType target floating point type to store results.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) the
+	 * input range consists of.
+	 *
+	 * \param first pointer to the beginning of the range to parse.
+	 * \param last pointer to the end of the range.
+	 * \param value reference to store the parsed value to. It's not modified,
+	 * if the function fails.
+	 * \param fmt format of the representation. Hexadecimal format is not
+	 * supported and always results in `std::errc::invalid_argument`.
+	 *
+	 * \return `basic_from_chars_result` structure with pointer to the first
+	 * character after the parsed value and error code, which is either
+	 * `std::errc::invalid_argument`, if there's no value representation at
+	 * the beginning of the range (the pointer is equal to \p **first** then),
+	 * or `std::errc::result_out_of_range`, if the value overflows or
+	 * underflows the type.
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_from_chars_result<CharType> from_chars(const CharType* first, const CharType* last, FloatType& value, chars_format fmt = chars_format::general) noexcept
+	{
+		basic_from_chars_result<CharType> ret { first, std::errc::invalid_argument };
+
+		// empty range may be represented by two null pointers, which
+		// mean null-terminated string for Krosh
+		if (first == last || *first == '+' || fmt == chars_format::hex)
+			return ret;
+
+		auto cr(krosh<FloatType>(first, last));
+
+		// Krosh consumes sign and decimal point even with no digits after
+		// them, but it's not a value without either mantissa digits or
+		// matched NaN or infinity literal
+		const auto is_digit = [](CharType c) { return c >= '0' && c <= '9'; };
+		if (cr.str_end == first || (!std::any_of(first, cr.str_end, is_digit) && std::isfinite(cr.value)))
+			return ret;
+
+		const unsigned char format_bits(static_cast<unsigned char>(fmt));
+		const bool exponent_allowed(format_bits & static_cast<unsigned char>(chars_format::scientific));
+		const bool exponent_required(!(format_bits & static_cast<unsigned char>(chars_format::fixed)));
+
+		if (is_numeric(first, cr.str_end))
+		{
+			const auto is_exponent = [](CharType c) { return c == 'e' || c == 'E'; };
+			const CharType* const exponent(std::find_if(first, cr.str_end, is_exponent));
+
+			if (exponent == cr.str_end && exponent_required)
+				return ret;
+
+			if (exponent != cr.str_end && !exponent_allowed)
+				cr = krosh<FloatType>(first, exponent);
+		}
+
+		const auto& result(exact_refine(first, cr));
+
+		ret.ptr = cr.str_end;
+		ret.ec = to_errc(result.status);
+
+		if (ret.ec == std::errc())
+			value = result.value;
+
+		return ret;
+	}
+
+	/** \brief Return structure for `to_chars()`, the same as
+	 * `std::to_chars_result` of C++17, but for any character type.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of
+	 * the output range.
+	 */
+	template<typename CharType> struct basic_to_chars_result
+	{
+		/** \brief Pointer to the first character after the printed value
+		 * or end of the range in case of error.
+		 */
+		CharType* ptr;
+		/** \brief Error code of the conversion or value initialized
+		 * `std::errc` in case of success.
+		 */
+		std::errc ec;
+	};
+
+	/** \brief `basic_to_chars_result` for `char` ranges. */
+	typedef basic_to_chars_result<char> to_chars_result;
+
+	/** \brief Copies string literal to the range, if it fits.
+	 *
+	 * \return `basic_to_chars_result` structure with the result.
+	 */
+	template<typename CharType, std::size_t N>
+	inline basic_to_chars_result<CharType> copy_literal(CharType* first, CharType* last, const char (&literal)[N]) noexcept
+	{
+		constexpr std::size_t length(N - 1);
+
+		if (std::size_t(last - first) < length)
+			return { last, std::errc::value_too_large };
+
+		return { std::copy(literal, literal + length, first), std::errc() };
+	}
+
+	/** \brief Format options of the exponent `std::to_chars()` prints
+	 * (always signed and at least two digits long).
+	 */
+	struct std_format_options : default_format_options
+	{
+		static constexpr bool exponent_plus = true;
+	};
+
+	/** \brief Calculates the number of characters `print_std_scientific()`
+	 * writes.
+	 *
+	 * \param len number of printed digits.
+	 * \param k decimal exponent of the value.
+	 */
+	inline std::size_t std_scientific_length(const unsigned int len, const int k) noexcept
+	{
+		const int exponent(static_cast<int>(len) + k - 1);
+		return len + /*dot*/(len > 1) + /*'e' and sign*/2 + /*exp digits*/2 + (std::abs(exponent) >= 100);
+	}
+
+	/** \brief Formats printed digits in decimal exponent format with the
+	 * exponent of `std::to_chars()` style (e.g. "1.5e+16").
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer \p **buffer**.
+	 *
+	 * \param buffer character buffer with printed digits, which should have
+	 * room for at least `std_scientific_length()` characters.
+	 * \param len number of printed digits.
+	 * \param k decimal exponent of the value.
+	 *
+	 * \return number of characters written to the buffer.
+	 */
+	template<typename CharType> inline std::size_t print_std_scientific(CharType* buffer, const unsigned int len, const int k) noexcept
+	{
+		if (len > 1)
+		{
+			std::copy_backward(buffer + 1, buffer + len, buffer + len + 1);
+			buffer[1] = '.';
+		}
+
+		const std::size_t mantissa_length(len + (len > 1));
+		return mantissa_length + print_exponent(static_cast<int>(len) + k - 1, buffer + mantissa_length, std_format_options());
+	}
+
+	/** \brief Chooses format of the representation the way `std::to_chars()`
+	 * does.
+	 *
+	 * With no format specified (\p **plain** is `true`) the shorter of
+	 * decimal and decimal exponent representations is chosen (decimal one,
+	 * if they are of the same length). `chars_format::general` means the
+	 * style of `printf()` `%g` conversion with the default precision, i.e.
+	 * decimal exponent format is used, if the exponent is less, than -4, or
+	 * not less, than 6.
+	 *
+	 * \param len number of printed digits.
+	 * \param k decimal exponent of the value.
+	 * \param fmt format of the representation requested.
+	 * \param plain if `true`, no format is requested.
+	 */
+	inline format choose_std_format(const unsigned int len, const int k, const chars_format fmt, const bool plain) noexcept
+	{
+		const int exponent(static_cast<int>(len) + k - 1);
+
+		if (plain)
+			return std_scientific_length(len, k) < decimal_length(len, k) ? format::scientific : format::decimal;
+
+		switch (fmt)
+		{
+		case chars_format::scientific:
+			return format::scientific;
+
+		case chars_format::fixed:
+			return format::decimal;
+
+		default:
+			return exponent < -4 || exponent >= 6 ? format::scientific : format::decimal;
+		}
+	}
+
+	/** \brief Implementation of `to_chars()` overloads with and without
+	 * format specified.
+	 *
+	 * \param plain if `true`, no format is specified (\p **fmt** is ignored
+	 * then).
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_to_chars_result<CharType> to_chars_shortest(CharType* first, CharType* last, FloatType v, chars_format fmt, bool plain) noexcept
+	{
+		if (fmt == chars_format::hex && !plain)
+			return { last, std::errc::invalid_argument };
+
+		if (!std::isfinite(v))
+		{
+			CharType buffer[4];
+			const std::size_t length(print_special_precision(v, buffer));
+
+			if (std::size_t(last - first) < length)
+				return { last, std::errc::value_too_large };
+
+			return { std::copy(buffer, buffer + length, first), std::errc() };
+		}
+
+		if (std::signbit(v))
+		{
+			if (first == last)
+				return { last, std::errc::value_too_large };
+
+			*first++ = '-';
+		}
+
+		if (v == 0)
+			return fmt == chars_format::scientific && !plain ? copy_literal(first, last, "0e+00") : copy_literal(first, last, "0");
+
+		constexpr std::size_t digits_size(max_digits<FloatType>());
+
+		const std::size_t space(last - first);
+
+		CharType digits_buffer[digits_size];
+		CharType* const digits(space < digits_size ? digits_buffer : first);
+
+		plain_digit_writer<CharType> writer(digits);
+		int K;
+		dragonbox_engine::generate(std::fabs(v), writer, &K);
+
+		const unsigned int len(writer.length());
+		const format f(choose_std_format(len, K, fmt, plain));
+
+		// any digits in place of the trailing zeros give the same length,
+		// so the closest, i.e. exact, integral value is printed
+		if (f == format::decimal && K > 0)
+		{
+			precision_digits pd;
+			prepare_precision(std::fabs(v), chars_format::fixed, 0, pd);
+
+			if (fixed_length(pd) > space)
+				return { last, std::errc::value_too_large };
+
+			return { first + print_fixed(pd, first), std::errc() };
+		}
+
+		const std::size_t length(f == format::decimal ? decimal_length(len, K) : std_scientific_length(len, K));
+
+		if (length > space)
+			return { last, std::errc::value_too_large };
+
+		if (digits != first)
+			std::copy(digits, digits + len, first);
+
+		if (f == format::decimal)
+			print_decimal(first, len, K);
+		else
+			print_std_scientific(first, len, K);
+
+		return { first + length, std::errc() };
+	}
+
+	/** \brief Prints floating point value to the range with semantics of
+	 * `std::to_chars()`.
+	 *
+	 * Prints the same representation as `std::to_chars()` does with the
+	 * format specified, i.e. the shortest one, which is parsed back to the
+	 * same value (generated by `dragonbox_engine`) and the closest to it
+	 * among such ones (integral values are exact), with the exponent being
+	 * signed and at least two digits long (e.g. "1e+16"). The format is
+	 * chosen the way `choose_std_format()` describes. At most `last` -
+	 * `first` characters are written and no terminating null character is
+	 * written, so that values can be printed right to the tail of bigger
+	 * output buffer. If the range is not shorter, than `max_digits()` (plus
+	 * one for the sign), the digits are generated in the range directly,
+	 * otherwise they are generated in small temporary buffer and copied to
+	 * the range, if the representation fits.
+	 *
+	 * \tparam FloatType type of floating point value, calculated using passed
+	 * input parameter \p **v**.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output range.
+	 *
+	 * \param first pointer to the beginning of the output range.
+	 * \param last pointer to the end of the output range.
+	 * \param v floating point value to print.
+	 * \param fmt format of the representation. Hexadecimal format is not
+	 * supported and always results in `std::errc::invalid_argument`.
+	 *
+	 * \return `basic_to_chars_result` structure with pointer to the first
+	 * character after the printed value and error code, which is
+	 * `std::errc::value_too_large`, if the representation doesn't fit the
+	 * range (the pointer is equal to \p **last** then, and the contents of
+	 * the range are unspecified).
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_to_chars_result<CharType> to_chars(CharType* first, CharType* last, FloatType v, chars_format fmt) noexcept
+	{
+		return to_chars_shortest(first, last, v, fmt, false);
+	}
+
+	/** \brief Prints floating point value to the range with semantics of
+	 * `std::to_chars()` with no format specified, i.e. in the shorter of
+	 * decimal and decimal exponent formats.
+	 *
+	 * \see `to_chars()` with format specified
+	 * \see `choose_std_format()`
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_to_chars_result<CharType> to_chars(CharType* first, CharType* last, FloatType v) noexcept
+	{
+		return to_chars_shortest(first, last, v, chars_format::general, true);
+	}
+
+	/** \brief Prints floating point value with the specified precision to the
+	 * range with semantics of `std::to_chars()`.
+	 *
+	 * Prints the same representation as `ftoa_precision()` does, i.e. the one
+	 * of `printf()` with `%.*f`, `%.*e` or `%.*g` conversion (depending on
+	 * \p **fmt**), but never writes more, than `last` - `first` characters
+	 * and doesn't write terminating null character.
+	 *
+	 * \tparam FloatType type of floating point value, calculated using passed
+	 * input parameter \p **v**.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output range.
+	 *
+	 * \param first pointer to the beginning of the output range.
+	 * \param last pointer to the end of the output range.
+	 * \param v floating point value to print.
+	 * \param fmt format of the representation. Hexadecimal format is not
+	 * supported and always results in `std::errc::invalid_argument`.
+	 * \param precision precision of the representation (negative value means
+	 * `default_precision`).
+	 *
+	 * \return `basic_to_chars_result` structure with pointer to the first
+	 * character after the printed value and error code, which is
+	 * `std::errc::value_too_large`, if the representation doesn't fit the
+	 * range (the pointer is equal to \p **last** then, and the contents of
+	 * the range are unspecified).
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_to_chars_result<CharType> to_chars(CharType* first, CharType* last, FloatType v, chars_format fmt, int precision) noexcept
+	{
+		if (fmt == chars_format::hex)
+			return { last, std::errc::invalid_argument };
+
+		if (!std::isfinite(v))
+		{
+			CharType buffer[4];
+			const std::size_t length(print_special_precision(v, buffer));
+
+			if (std::size_t(last - first) < length)
+				return { last, std::errc::value_too_large };
+
+			return { std::copy(buffer, buffer + length, first), std::errc() };
+		}
+
+		if (std::signbit(v))
+		{
+			if (first == last)
+				return { last, std::errc::value_too_large };
+
+			*first++ = '-';
+		}
+
+		precision_digits pd;
+		const format f(prepare_precision(std::fabs(v), fmt, precision, pd));
+
+		const std::size_t length(precision_length(pd, f));
+
+		if (length > std::size_t(last - first))
+			return { last, std::errc::value_too_large };
+
+		print_precision(pd, f, first);
+
+		return { first + length, std::errc() };
+	}
+
+#ifdef FLOAXIE_HAS_STD_CHARS_FORMAT
+	/** \brief Converts `std::chars_format` to `chars_format`. */
+	constexpr chars_format to_chars_format(std::chars_format fmt) noexcept
+	{
+		return fmt == std::chars_format::scientific ? chars_format::scientific :
+			fmt == std::chars_format::fixed ? chars_format::fixed :
+			fmt == std::chars_format::hex ? chars_format::hex :
+			chars_format::general;
+	}
+
+	/** \brief Overload of `from_chars()`, accepting `std::chars_format`, so
+	 * that it's a drop-in replacement of `std::from_chars()`.
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_from_chars_result<CharType> from_chars(const CharType* first, const CharType* last, FloatType& value, std::chars_format fmt) noexcept
+	{
+		return from_chars(first, last, value, to_chars_format(fmt));
+	}
+
+	/** \brief Overload of `to_chars()`, accepting `std::chars_format`, so
+	 * that it's a drop-in replacement of `std::to_chars()`.
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_to_chars_result<CharType> to_chars(CharType* first, CharType* last, FloatType v, std::chars_format fmt) noexcept
+	{
+		return to_chars(first, last, v, to_chars_format(fmt));
+	}
+
+	/** \brief Overload of `to_chars()` with precision, accepting
+	 * `std::chars_format`, so that it's a drop-in replacement of
+	 * `std::to_chars()`.
+	 */
+	template<typename FloatType, typename CharType>
+	inline basic_to_chars_result<CharType> to_chars(CharType* first, CharType* last, FloatType v, std::chars_format fmt, int precision) noexcept
+	{
+		return to_chars(first, last, v, to_chars_format(fmt), precision);
+	}
+#endif
+}
+
+#endif // FLOAXIE_CHARCONV_H
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_CHARS_FORMAT_H
+#define FLOAXIE_CHARS_FORMAT_H
+
+namespace floaxie
+{
+	/** \brief Floating point formats, the same as `std::chars_format`
+	 * of C++17.
+	 */
+	enum class chars_format : unsigned char
+	{
+		scientific = 1, /**< Exponent part is required. */
+		fixed = 2, /**< Exponent part is not allowed. */
+		hex = 4, /**< Hexadecimal representation (not supported). */
+		general = fixed | scientific /**< Exponent part is optional. */
+	};
+}
+
+#endif // FLOAXIE_CHARS_FORMAT_H
@@ -27,7 +27,8 @@ namespace floaxie
 
 		success, /**< The conversion was successful. */
 		underflow, /**< An underflow occurred during the conversion. */
-		overflow /**< An overflow occurred during the conversion. */
+		overflow, /**< An overflow occurred during the conversion. */
+		inexact /**< The result is not guaranteed to be correctly rounded, as no fallback conversion was made (see `no_fallback`). */
 	};
 }
 
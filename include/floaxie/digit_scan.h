@@ -0,0 +1,247 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_DIGIT_SCAN_H
+#define FLOAXIE_DIGIT_SCAN_H
+
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(FLOAXIE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLOAXIE_HAS_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define FLOAXIE_HAS_NEON
+#endif
+#endif
+
+#include <floaxie/bit_ops.h>
+
+namespace floaxie
+{
+	/** \brief Number of characters classified by one `scan_digit_run()` call. */
+	constexpr std::size_t digit_scan_width(16);
+
+	/** \brief Whether `scan_digit_run()` uses SIMD instructions for
+	 * \p **CharType** buffers.
+	 *
+	 * SSE2 and NEON are supported for `char` buffers, if `FLOAXIE_SIMD` is
+	 * defined. They are opt-in, as the portable code is as fast on typical
+	 * inputs of up to 40 digits.
+	 */
+	template<typename CharType> constexpr bool simd_digit_scan =
+#if defined(FLOAXIE_HAS_SSE2) || defined(FLOAXIE_HAS_NEON)
+		std::is_same<CharType, char>::value;
+#else
+		false;
+#endif
+
+	/** \brief Return structure for `scan_digit_run()`.
+	 *
+	 * Positions of the characters, which are not found, are equal to the
+	 * number of characters classified.
+	 */
+	struct digit_scan_result
+	{
+		/** \brief Number of decimal digits at the beginning of the buffer. */
+		std::size_t digits;
+
+		/** \brief Position of the first '.' character. */
+		std::size_t dot;
+
+		/** \brief Position of the first 'e' or 'E' character. */
+		std::size_t exponent;
+
+		/** \brief Number of decimal digits right after the decimal point,
+		 * which ends the leading run of digits (zero, if the run is not
+		 * ended by the decimal point).
+		 */
+		std::size_t fraction;
+	};
+
+	/** \brief Classifies characters of the buffer one by one.
+	 *
+	 * Portable version of `scan_digit_run()`.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * buffer.
+	 *
+	 * \param first pointer to the beginning of the buffer.
+	 * \param last pointer to the end of the buffer.
+	 *
+	 * \return `digit_scan_result` of at most `digit_scan_width` first
+	 * characters.
+	 */
+	template<typename CharType> inline digit_scan_result portable_scan_digit_run(const CharType* first, const CharType* last) noexcept
+	{
+		const std::size_t width(std::min(static_cast<std::size_t>(last - first), digit_scan_width));
+		digit_scan_result ret { width, width, width, 0 };
+
+		for (std::size_t i = 0; i < width; ++i)
+		{
+			const CharType c(first[i]);
+
+			if (ret.digits == width && (c < '0' || c > '9'))
+				ret.digits = i;
+
+			if (ret.dot == width && c == '.')
+				ret.dot = i;
+
+			if (ret.exponent == width && (c == 'e' || c == 'E'))
+				ret.exponent = i;
+		}
+
+		if (ret.dot == ret.digits)
+		{
+			for (std::size_t i = ret.dot + 1; i < width && first[i] >= '0' && first[i] <= '9'; ++i)
+				++ret.fraction;
+		}
+
+		return ret;
+	}
+
+#if defined(FLOAXIE_HAS_SSE2)
+	/** \brief Classifies `digit_scan_width` characters by one SSE2 load.
+	 *
+	 * \param str character buffer of at least `digit_scan_width` characters.
+	 *
+	 * \return `digit_scan_result` of the characters.
+	 */
+	inline digit_scan_result simd_scan_digit_run(const char* str) noexcept
+	{
+		const __m128i chars(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str)));
+
+		const __m128i digits(_mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1))));
+		const __m128i dots(_mm_cmpeq_epi8(chars, _mm_set1_epi8('.')));
+		const __m128i exponents(_mm_cmpeq_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('e')));
+
+		// the bit after the mask limits the positions of the characters not found
+		constexpr std::uint32_t stop_bit(std::uint32_t(1) << digit_scan_width);
+
+		const std::uint32_t non_digits(~std::uint32_t(_mm_movemask_epi8(digits)) & (stop_bit - 1));
+		const std::uint32_t dot_mask(std::uint32_t(_mm_movemask_epi8(dots)));
+
+		// the decimal point ends the leading run, if it's the first non-digit,
+		// and the run after it is ended by the second one
+		const std::size_t run(count_trailing_zeros(non_digits | stop_bit));
+		const std::size_t dot(count_trailing_zeros(dot_mask | stop_bit));
+		const std::size_t fraction(dot == run && dot < digit_scan_width ? count_trailing_zeros((non_digits & (non_digits - 1)) | stop_bit) - dot - 1 : 0);
+
+		return digit_scan_result
+		{
+			run,
+			dot,
+			std::size_t(count_trailing_zeros(std::uint32_t(_mm_movemask_epi8(exponents)) | stop_bit)),
+			fraction
+		};
+	}
+#elif defined(FLOAXIE_HAS_NEON)
+	/** \brief Narrows each lane of NEON comparison result to four bits of
+	 * a 64-bit value, as there's no byte mask extraction in NEON.
+	 */
+	inline std::uint64_t lane_nibbles(uint8x16_t lanes) noexcept
+	{
+		return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(lanes), 4)), 0);
+	}
+
+	/** \brief Returns position of the first set lane of the nibbles of
+	 * `lane_nibbles()` or `digit_scan_width`, if there's none.
+	 */
+	inline std::size_t first_set_lane(std::uint64_t nibbles) noexcept
+	{
+		return nibbles ? std::size_t(count_trailing_zeros(nibbles)) / 4 : digit_scan_width;
+	}
+
+	/** \brief Classifies `digit_scan_width` characters by one NEON load.
+	 *
+	 * \param str character buffer of at least `digit_scan_width` characters.
+	 *
+	 * \return `digit_scan_result` of the characters.
+	 */
+	inline digit_scan_result simd_scan_digit_run(const char* str) noexcept
+	{
+		const uint8x16_t chars(vld1q_u8(reinterpret_cast<const std::uint8_t*>(str)));
+
+		const uint8x16_t non_digits(vcgeq_u8(vsubq_u8(chars, vdupq_n_u8('0')), vdupq_n_u8(10)));
+		const uint8x16_t dots(vceqq_u8(chars, vdupq_n_u8('.')));
+		const uint8x16_t exponents(vceqq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('e')));
+
+		const std::uint64_t non_digit_nibbles(lane_nibbles(non_digits));
+		const std::size_t run(first_set_lane(non_digit_nibbles));
+		const std::size_t dot(first_set_lane(lane_nibbles(dots)));
+
+		// the decimal point ends the leading run, if it's the first non-digit,
+		// and the run after it is ended by the second one
+		const std::size_t fraction(dot == run && dot < digit_scan_width ?
+			first_set_lane(non_digit_nibbles & ~(std::uint64_t(0xf) << (4 * dot))) - dot - 1 : 0);
+
+		return digit_scan_result { run, dot, first_set_lane(lane_nibbles(exponents)), fraction };
+	}
+#endif
+
+	/** \brief Classifies characters at the beginning of the buffer.
+	 *
+	 * Finds the length of the run of decimal digits, positions of the
+	 * decimal point and exponent characters and the length of the run of
+	 * digits after the decimal point, if it ends the first run, among at
+	 * most `digit_scan_width` first characters of the buffer. Other character
+	 * types, than `char`, and builds without `FLOAXIE_SIMD` use
+	 * `portable_scan_digit_run()`.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * buffer.
+	 *
+	 * \param first pointer to the beginning of the buffer.
+	 * \param last pointer to the end of the buffer.
+	 *
+	 * \return `digit_scan_result` of the characters classified.
+	 *
+	 * \see `simd_digit_scan`
+	 */
+	template<typename CharType> inline digit_scan_result scan_digit_run(const CharType* first, const CharType* last) noexcept
+	{
+		return portable_scan_digit_run(first, last);
+	}
+
+	/** \brief `char` version of `scan_digit_run()`.
+	 *
+	 * Buffers shorter, than `digit_scan_width`, are copied to a local one
+	 * padded by null characters, not to read beyond their end.
+	 */
+	inline digit_scan_result scan_digit_run(const char* first, const char* last) noexcept
+	{
+#if defined(FLOAXIE_HAS_SSE2) || defined(FLOAXIE_HAS_NEON)
+		const std::size_t width(static_cast<std::size_t>(last - first));
+
+		if (width >= digit_scan_width)
+			return simd_scan_digit_run(first);
+
+		char padded[digit_scan_width] = { };
+		std::copy(first, last, padded);
+
+		const auto& ret(simd_scan_digit_run(padded));
+		return digit_scan_result { ret.digits, std::min(ret.dot, width), std::min(ret.exponent, width), ret.fraction };
+#else
+		return portable_scan_digit_run(first, last);
+#endif
+	}
+}
+
+#endif // FLOAXIE_DIGIT_SCAN_H
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_DIGITS_LUT_H
+#define FLOAXIE_DIGITS_LUT_H
+
+#include <cstdint>
+
+namespace floaxie
+{
+	/** \brief LUT of two-digit decimal values to speed up their printing. */
+	constexpr const char digits_lut[200] = {
+		'0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
+		'1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
+		'2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
+		'3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
+		'4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
+		'5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
+		'6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
+		'7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
+		'8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
+		'9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'
+	};
+
+	/** \brief Prints decimal digits of the value, two at a time.
+	 *
+	 * The digits are written from right to left, taking pairs of them from
+	 * `digits_lut`, so that only one division is needed per two digits.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer \p **buffer**.
+	 *
+	 * \param buffer character buffer to print to.
+	 * \param value the value to print.
+	 * \param count number of decimal digits to print. The value is padded
+	 * with leading zeros, if it has less digits, and is expected to have
+	 * not more of them.
+	 */
+	template<typename CharType> inline void print_digits(CharType* buffer, std::uint32_t value, unsigned int count) noexcept
+	{
+		CharType* p(buffer + count);
+
+		while (p - buffer >= 2)
+		{
+			const char* d = digits_lut + (value % 100) * 2;
+			value /= 100;
+
+			p -= 2;
+			p[0] = d[0];
+			p[1] = d[1];
+		}
+
+		if (p != buffer)
+			p[-1] = CharType('0' + value);
+	}
+}
+
+#endif // FLOAXIE_DIGITS_LUT_H
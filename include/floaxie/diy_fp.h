@@ -35,6 +35,7 @@
 #include <floaxie/print.h>
 #include <floaxie/type_punning_cast.h>
 #include <floaxie/huge_val.h>
+#include <floaxie/wide_multiply.h>
 #include <floaxie/conversion_status.h>
 
 namespace floaxie
@@ -181,9 +182,13 @@ namespace floaxie
 		 * and the whole `diy_fp` value is normalized, otherwise the behaviour is
 		 * undefined.
 		 *
+		 * \param error maximum absolute error of the mantissa value (in units
+		 * of its last place) to take into account, when checking, if the
+		 * result is rounded correctly.
+		 *
 		 * \return result structure with floating point value of the specified type.
 		 */
-		downsample_result downsample()
+		downsample_result downsample(mantissa_storage_type error = 0)
 		{
 			downsample_result ret;
 
@@ -197,39 +202,63 @@ namespace floaxie
 			constexpr auto full_mantissa_bit_size(std::numeric_limits<FloatType>::digits);
 			constexpr auto mantissa_bit_size(full_mantissa_bit_size - 1); // remember hidden bit
 			constexpr mantissa_storage_type my_mantissa_size(bit_size<mantissa_storage_type>());
-			constexpr mantissa_storage_type mantissa_mask(mask<mantissa_storage_type>(mantissa_bit_size));
 			constexpr exponent_storage_type exponent_bias(std::numeric_limits<FloatType>::max_exponent - 1 + mantissa_bit_size);
 			constexpr std::size_t lsb_pow(my_mantissa_size - full_mantissa_bit_size);
 
+			constexpr int min_denorm_pow(std::numeric_limits<FloatType>::min_exponent - 1 - int(mantissa_bit_size));
+			constexpr mantissa_storage_type infinity_exponent(2 * std::numeric_limits<FloatType>::max_exponent - 1);
+
 			const auto f(m_f);
 
-			if (m_e >= std::numeric_limits<FloatType>::max_exponent)
+			// normalized value lays in [2 ^ (m_e + my_mantissa_size - 1), 2 ^ (m_e + my_mantissa_size))
+			if (m_e + int(my_mantissa_size) > std::numeric_limits<FloatType>::max_exponent)
 			{
 				ret.value = huge_value<FloatType>();
 				ret.status = conversion_status::overflow;
 				return ret;
 			}
 
-			if (m_e + int(my_mantissa_size) < std::numeric_limits<FloatType>::min_exponent - int(mantissa_bit_size))
+			if (m_e + int(my_mantissa_size) < min_denorm_pow)
 			{
 				ret.value = FloatType(0);
 				ret.status = conversion_status::underflow;
 				return ret;
 			}
 
-			const std::size_t denorm_exp(positive_part(std::numeric_limits<FloatType>::min_exponent - int(mantissa_bit_size) - m_e - 1));
+			// the value is around half of minimum denormalized value
+			if (m_e + int(my_mantissa_size) == min_denorm_pow)
+			{
+				const bool above_half(f != msb_value<mantissa_storage_type>());
+				ret.value = above_half ? std::numeric_limits<FloatType>::denorm_min() : FloatType(0);
+				ret.status = above_half ? conversion_status::success : conversion_status::underflow;
+				ret.is_accurate = false;
+				return ret;
+			}
+
+			const std::size_t denorm_exp(positive_part(min_denorm_pow - m_e));
 
 			assert(denorm_exp < my_mantissa_size);
 
 			const std::size_t shift_amount(std::max(denorm_exp, lsb_pow));
 
-			mantissa_storage_type parts = m_e + shift_amount + exponent_bias - (denorm_exp > lsb_pow);
+			// hidden bit (if any) of the shifted mantissa increments the exponent,
+			// as well as carry of rounding up does
+			mantissa_storage_type parts = m_e + shift_amount + exponent_bias - 1;
 			parts <<= mantissa_bit_size;
 
-			const auto& round(round_up(f, shift_amount));
-			parts |= ((f >> shift_amount) + round.value) & mantissa_mask;
+			const auto& round(round_up(f, shift_amount, error));
+			parts += (f >> shift_amount) + round.value;
+
+			if ((parts >> mantissa_bit_size) == infinity_exponent)
+			{
+				ret.value = huge_value<FloatType>();
+				ret.status = conversion_status::overflow;
+			}
+			else
+			{
+				ret.value = type_punning_cast<FloatType>(parts);
+			}
 
-			ret.value = type_punning_cast<FloatType>(parts);
 			ret.is_accurate = round.is_accurate;
 
 			return ret;
@@ -268,11 +297,10 @@ namespace floaxie
 		{
 			assert(m_f != 0); // normalization of zero is undefined
 
-			while (!highest_bit(m_f))
-			{
-				m_f <<= 1;
-				m_e--;
-			}
+			const int shift_amount(count_leading_zeros(m_f));
+
+			m_f <<= shift_amount;
+			m_e -= shift_amount;
 		}
 
 		/** \brief Copy assignment operator. */
@@ -310,7 +338,9 @@ namespace floaxie
 		 * Performs multiplication of `diy_fp` values ignoring some carriers
 		 * for the sake of performance. This multiplication algorithm is used
 		 * in original **Grisu** implementation and also works fine for
-		 * **Krosh**.
+		 * **Krosh**. The higher half of the product is calculated by
+		 * `rounded_multiply_high()`, which uses hardware wide multiplication,
+		 * where available.
 		 *
 		 * \param rhs multiplier.
 		 *
@@ -319,22 +349,7 @@ namespace floaxie
 		 */
 		diy_fp& operator*=(const diy_fp& rhs) noexcept
 		{
-			constexpr std::size_t half_width = bit_size<mantissa_storage_type>() / 2;
-			constexpr auto mask_half = mask<mantissa_storage_type>(half_width);
-
-			const mantissa_storage_type a = m_f >> half_width;
-			const mantissa_storage_type b = m_f & mask_half;
-			const mantissa_storage_type c = rhs.m_f >> half_width;
-			const mantissa_storage_type d = rhs.m_f & mask_half;
-
-			const mantissa_storage_type ac = a * c;
-			const mantissa_storage_type bc = b * c;
-			const mantissa_storage_type ad = a * d;
-			const mantissa_storage_type bd = b * d;
-
-			const mantissa_storage_type tmp = (bd >> half_width) + (ad & mask_half) + (bc & mask_half) + raised_bit<mantissa_storage_type>(half_width - 1);
-
-			m_f = ac + (ad >> half_width) + (bc >> half_width) + (tmp >> half_width);
+			m_f = rounded_multiply_high(m_f, rhs.m_f);
 			m_e += rhs.m_e + bit_size<mantissa_storage_type>();
 
 			return *this;
@@ -477,13 +492,8 @@ namespace floaxie
 		}
 
 	private:
-		/** \brief Normalizes the value using additional information on
-		 * mantissa content of the `FloatType`.
-
-		 * Mantissa value is treated as of the width defined in
-		 * `std::numeric_limits`. This information speeds up the normalization,
-		 * allowing to shift the value by several positions right at one take,
-		 * rather than shifting it by one step and checking if it's still not normalized.
+		/** \brief Normalizes the value, which is known to be represented in
+		 * IEEE-754 format (possibly with one more bit of precision).
 		 *
 		 * The caller should ensure, that the current mantissa value is not null
 		 * and is really represented in IEEE-754 format, otherwise the behaviour
@@ -496,18 +506,9 @@ namespace floaxie
 			static_assert(mantissa_bit_width >= 0, "Mantissa bit width should be positive.");
 
 			assert(m_f != 0); // normalization of zero is undefined
+			assert(m_f >> mantissa_bit_width <= 1);
 
-			while (!nth_bit(m_f, mantissa_bit_width))
-			{
-				m_f <<= 1;
-				m_e--;
-			}
-
-			constexpr mantissa_storage_type my_mantissa_size(bit_size<mantissa_storage_type>());
-			constexpr mantissa_storage_type e_diff = my_mantissa_size - mantissa_bit_width - 1;
-
-			m_f <<= e_diff;
-			m_e -= e_diff;
+			normalize();
 		}
 
 		mantissa_storage_type m_f;
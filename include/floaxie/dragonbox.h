@@ -0,0 +1,403 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * dragonbox() function implements the algorithm by Junekey Jeon, as
+ * described in "Dragonbox: A New Floating-Point Binary-to-Decimal
+ * Conversion Algorithm" paper
+ * (https://github.com/jk-jeon/dragonbox/blob/master/other_files/Dragonbox.pdf)
+ * and implemented in the reference implementation
+ * (https://github.com/jk-jeon/dragonbox)
+ */
+
+#ifndef FLOAXIE_DRAGONBOX_H
+#define FLOAXIE_DRAGONBOX_H
+
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+#include <floaxie/diy_fp.h>
+#include <floaxie/k_comp.h>
+#include <floaxie/static_pow.h>
+#include <floaxie/bit_ops.h>
+#include <floaxie/powers_ten_128.h>
+#include <floaxie/wide_multiply.h>
+
+namespace floaxie
+{
+	/** \brief Result of multiplication by cached power in `dragonbox()`. */
+	template<typename CarrierType> struct dragonbox_mul_result
+	{
+		/** \brief Integer part of the product. */
+		CarrierType integer_part;
+		/** \brief Flag indicating, if the product is integer. */
+		bool is_integer;
+	};
+
+	/** \brief Result of parity check of the product in `dragonbox()`. */
+	struct dragonbox_parity_result
+	{
+		/** \brief Parity of integer part of the product. */
+		bool parity;
+		/** \brief Flag indicating, if the product is integer. */
+		bool is_integer;
+	};
+
+	/** \brief Returns 128-bit significand of 10 ^ \p **k**, rounded up.
+	 *
+	 * The values in `powers_ten_128` are rounded up only for powers in the
+	 * range of [-27, -1], and are exact for the ones in the range of
+	 * [0, 55], so the rest of them are incremented here.
+	 */
+	inline wide_product ceiled_power_ten_128(int k) noexcept
+	{
+		const std::size_t index(powers_ten_128::pow_0_offset + k);
+
+		wide_product ret;
+		ret.high = powers_ten_128::high[index];
+		ret.low = powers_ten_128::low[index];
+
+		if (k < -27 || k > 55)
+		{
+			++ret.low;
+			ret.high += !ret.low;
+		}
+
+		return ret;
+	}
+
+	/** \brief Template structure to define parameters and cached power
+	 * arithmetic of **Dragonbox** algorithm for selected floating point
+	 * types.
+	 */
+	template<typename FloatType> struct dragonbox_traits;
+
+	/** \brief `dragonbox_traits` specialization for `float`. */
+	template<> struct dragonbox_traits<float>
+	{
+		/** \brief Integer type of the significand. */
+		typedef std::uint32_t carrier_type;
+		/** \brief Type of cached power of ten. */
+		typedef std::uint64_t cache_type;
+
+		/** \brief Number of stored significand bits. */
+		static constexpr int significand_bits = 23;
+		/** \brief Decimal exponent of the smaller divisor. */
+		static constexpr int kappa = 1;
+		/** \brief Binary exponent, at which a tie is possible in the case
+		 * of shorter interval.
+		 */
+		static constexpr int shorter_interval_tie_exponent = -35;
+
+		/** \brief Returns 64-bit significand of 10 ^ \p **k**, rounded up. */
+		static cache_type cached_power(int k) noexcept
+		{
+			const wide_product p(ceiled_power_ten_128(k));
+			return p.high + (p.low != 0);
+		}
+
+		/** \brief Multiplies \p **u** by the cached power, returning higher
+		 * half of the product.
+		 */
+		static dragonbox_mul_result<carrier_type> compute_mul(carrier_type u, cache_type cache) noexcept
+		{
+			const std::uint64_t r(full_multiply(std::uint64_t(u) << 32, cache).high);
+			return { carrier_type(r >> 32), carrier_type(r) == 0 };
+		}
+
+		/** \brief Calculates the width of the interval in the units of
+		 * the smaller divisor.
+		 */
+		static std::uint32_t compute_delta(cache_type cache, int beta) noexcept
+		{
+			return std::uint32_t(cache >> (64 - 1 - beta));
+		}
+
+		/** \brief Checks parity and integrality of the product of \p
+		 * **two_f** and the cached power.
+		 */
+		static dragonbox_parity_result compute_mul_parity(carrier_type two_f, cache_type cache, int beta) noexcept
+		{
+			assert(beta >= 1 && beta < 64);
+
+			const std::uint64_t r(two_f * cache);
+			return { ((r >> (64 - beta)) & 1) != 0, std::uint32_t(r >> (32 - beta)) == 0 };
+		}
+
+		/** \brief Returns higher 64 bits of the cached power. */
+		static std::uint64_t high(cache_type cache) noexcept
+		{
+			return cache;
+		}
+	};
+
+	/** \brief `dragonbox_traits` specialization for `double`. */
+	template<> struct dragonbox_traits<double>
+	{
+		/** \brief Integer type of the significand. */
+		typedef std::uint64_t carrier_type;
+		/** \brief Type of cached power of ten. */
+		typedef wide_product cache_type;
+
+		/** \brief Number of stored significand bits. */
+		static constexpr int significand_bits = 52;
+		/** \brief Decimal exponent of the smaller divisor. */
+		static constexpr int kappa = 2;
+		/** \brief Binary exponent, at which a tie is possible in the case
+		 * of shorter interval.
+		 */
+		static constexpr int shorter_interval_tie_exponent = -77;
+
+		/** \brief Returns 128-bit significand of 10 ^ \p **k**, rounded up. */
+		static cache_type cached_power(int k) noexcept
+		{
+			return ceiled_power_ten_128(k);
+		}
+
+		/** \brief Multiplies \p **u** by the cached power, returning higher
+		 * 128 bits of 192-bit product.
+		 */
+		static dragonbox_mul_result<carrier_type> compute_mul(carrier_type u, const cache_type& cache) noexcept
+		{
+			wide_product r(full_multiply(u, cache.high));
+			const std::uint64_t addend(full_multiply(u, cache.low).high);
+
+			r.low += addend;
+			r.high += r.low < addend;
+
+			return { r.high, r.low == 0 };
+		}
+
+		/** \brief Calculates the width of the interval in the units of
+		 * the smaller divisor.
+		 */
+		static std::uint32_t compute_delta(const cache_type& cache, int beta) noexcept
+		{
+			return std::uint32_t(cache.high >> (64 - 1 - beta));
+		}
+
+		/** \brief Checks parity and integrality of the product of \p
+		 * **two_f** and the cached power.
+		 */
+		static dragonbox_parity_result compute_mul_parity(carrier_type two_f, const cache_type& cache, int beta) noexcept
+		{
+			assert(beta >= 1 && beta < 64);
+
+			// lower 128 bits of 192-bit product
+			const wide_product low_product(full_multiply(two_f, cache.low));
+			const std::uint64_t r_high(two_f * cache.high + low_product.high);
+			const std::uint64_t r_low(low_product.low);
+
+			return { ((r_high >> (64 - beta)) & 1) != 0, ((r_high << beta) | (r_low >> (64 - beta))) == 0 };
+		}
+
+		/** \brief Returns higher 64 bits of the cached power. */
+		static std::uint64_t high(const cache_type& cache) noexcept
+		{
+			return cache.high;
+		}
+	};
+
+	/** \brief Result structure of `dragonbox()`.
+	 *
+	 * The value is `significand` * 10 ^ `exponent`.
+	 */
+	template<typename FloatType> struct dragonbox_result
+	{
+		/** \brief Decimal significand without trailing zeros. */
+		typename dragonbox_traits<FloatType>::carrier_type significand;
+		/** \brief Decimal exponent. */
+		int exponent;
+	};
+
+	/** \brief Moves trailing decimal zeros of \p **significand** to \p
+	 * **exponent**.
+	 */
+	template<typename CarrierType> inline void remove_trailing_zeros(CarrierType& significand, int& exponent) noexcept
+	{
+		constexpr CarrierType chunk_pow(static_pow<10, 8>());
+
+		// short representations of `double` values have many of them
+		if (sizeof(CarrierType) > sizeof(std::uint32_t) && significand % chunk_pow == 0)
+		{
+			significand /= chunk_pow;
+			exponent += 8;
+		}
+
+		while (significand % 100 == 0)
+		{
+			significand /= 100;
+			exponent += 2;
+		}
+
+		if (significand % 10 == 0)
+		{
+			significand /= 10;
+			++exponent;
+		}
+	}
+
+	/** \brief **Dragonbox** algorithm for the values, which are powers of 2,
+	 * so that the lower boundary is closer to them, than the upper one.
+	 *
+	 * \param exponent binary exponent of the value.
+	 */
+	template<typename FloatType> inline dragonbox_result<FloatType> dragonbox_shorter_interval(int exponent) noexcept
+	{
+		typedef dragonbox_traits<FloatType> traits;
+		typedef typename traits::carrier_type carrier_type;
+
+		constexpr int shift(64 - traits::significand_bits - 1);
+
+		const int minus_k(floor_log10_pow2_minus_log10_4_over_3(exponent));
+		const int beta(exponent + floor_log2_pow10(-minus_k));
+
+		const std::uint64_t cache(traits::high(traits::cached_power(-minus_k)));
+
+		carrier_type xi((cache - (cache >> (traits::significand_bits + 2))) >> (shift - beta));
+		const carrier_type zi((cache + (cache >> (traits::significand_bits + 1))) >> (shift - beta));
+
+		// the left endpoint is integer only for these exponents
+		if (exponent < 2 || exponent > 3)
+			++xi;
+
+		dragonbox_result<FloatType> ret;
+		ret.significand = zi / 10;
+
+		if (ret.significand * 10 >= xi)
+		{
+			ret.exponent = minus_k + 1;
+			remove_trailing_zeros(ret.significand, ret.exponent);
+			return ret;
+		}
+
+		// the closest one to the value
+		ret.significand = carrier_type(((cache >> (shift - 1 - beta)) + 1) / 2);
+		ret.exponent = minus_k;
+
+		if (exponent == traits::shorter_interval_tie_exponent)
+			ret.significand -= ret.significand % 2;
+		else if (ret.significand < xi)
+			++ret.significand;
+
+		return ret;
+	}
+
+	/** \brief **Dragonbox** algorithm implementation.
+	 *
+	 * Finds the shortest decimal representation of the value, which is the
+	 * closest to it (ties are resolved to even significand), by only one or
+	 * two multiplications by 128-bit (64-bit for `float`) cached power of ten,
+	 * taken from `powers_ten_128` table. In contrast to **Grisu3**, it never
+	 * fails.
+	 *
+	 * \tparam FloatType type of floating point value.
+	 *
+	 * \param v positive floating point value to convert.
+	 *
+	 * \return `dragonbox_result` structure with the decimal representation.
+	 */
+	template<typename FloatType> inline dragonbox_result<FloatType> dragonbox(FloatType v) noexcept
+	{
+		typedef dragonbox_traits<FloatType> traits;
+		typedef typename traits::carrier_type carrier_type;
+
+		constexpr carrier_type hidden_bit(raised_bit<carrier_type>(traits::significand_bits));
+		constexpr std::uint32_t small_divisor(static_pow<10, traits::kappa>());
+		constexpr std::uint32_t big_divisor(static_pow<10, traits::kappa + 1>());
+
+		const diy_fp<FloatType> w(v);
+		const int exponent(w.exponent());
+
+		assert(w.mantissa());
+
+		// denormalized values never have their mantissa equal to hidden bit
+		if (w.mantissa() == hidden_bit)
+			return dragonbox_shorter_interval<FloatType>(exponent);
+
+		const carrier_type two_fc(w.mantissa() << 1);
+		const bool include_endpoints(!(w.mantissa() & 1));
+
+		const int minus_k(floor_log10_pow2(exponent) - traits::kappa);
+		const auto cache(traits::cached_power(-minus_k));
+		const int beta(exponent + floor_log2_pow10(-minus_k));
+
+		// 10 ^ kappa <= delta < 10 ^ (kappa + 1)
+		const std::uint32_t delta(traits::compute_delta(cache, beta));
+		const auto z_mul(traits::compute_mul((two_fc | 1) << beta, cache));
+
+		dragonbox_result<FloatType> ret;
+
+		// try the bigger divisor first
+		ret.significand = z_mul.integer_part / big_divisor;
+		std::uint32_t r(std::uint32_t(z_mul.integer_part - big_divisor * ret.significand));
+
+		bool small_divisor_case(false);
+
+		if (r < delta)
+		{
+			// exclude the right endpoint, if needed
+			if (r == 0 && z_mul.is_integer && !include_endpoints)
+			{
+				--ret.significand;
+				r = big_divisor;
+				small_divisor_case = true;
+			}
+		}
+		else if (r > delta)
+		{
+			small_divisor_case = true;
+		}
+		else
+		{
+			// compare the fractional parts
+			const dragonbox_parity_result x_mul(traits::compute_mul_parity(two_fc - 1, cache, beta));
+			small_divisor_case = !(x_mul.parity || (x_mul.is_integer && include_endpoints));
+		}
+
+		if (!small_divisor_case)
+		{
+			ret.exponent = minus_k + traits::kappa + 1;
+			remove_trailing_zeros(ret.significand, ret.exponent);
+			return ret;
+		}
+
+		// find the closest representation with the smaller divisor
+		ret.significand *= 10;
+		ret.exponent = minus_k + traits::kappa;
+
+		std::uint32_t dist(r - (delta / 2) + (small_divisor / 2));
+		const bool approx_y_parity(((dist ^ (small_divisor / 2)) & 1) != 0);
+
+		const bool divisible(dist % small_divisor == 0);
+		dist /= small_divisor;
+
+		ret.significand += dist;
+
+		if (divisible)
+		{
+			// the value may be closer to the representation below or be a tie
+			const dragonbox_parity_result y_mul(traits::compute_mul_parity(two_fc, cache, beta));
+
+			if (y_mul.parity != approx_y_parity || (y_mul.is_integer && (ret.significand & 1)))
+				--ret.significand;
+		}
+
+		return ret;
+	}
+}
+
+#endif // FLOAXIE_DRAGONBOX_H
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * eisel_lemire() function implements the algorithm by Michael Eisel and
+ * Daniel Lemire, as described in "Number Parsing at a Gigabyte per Second"
+ * paper (https://arxiv.org/abs/2101.11408) and implemented in fast_float
+ * library (https://github.com/fastfloat/fast_float)
+ */
+
+#ifndef FLOAXIE_EISEL_LEMIRE_H
+#define FLOAXIE_EISEL_LEMIRE_H
+
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+#include <floaxie/diy_fp.h>
+#include <floaxie/huge_val.h>
+#include <floaxie/powers_ten_128.h>
+#include <floaxie/wide_multiply.h>
+#include <floaxie/type_punning_cast.h>
+#include <floaxie/conversion_status.h>
+
+namespace floaxie
+{
+	/** \brief Template structure to define parameters of Eisel-Lemire
+	 * algorithm for selected floating point types.
+	 */
+	template<typename FloatType> struct eisel_lemire_traits;
+
+	/** \brief `eisel_lemire_traits` specialization for `float`. */
+	template<> struct eisel_lemire_traits<float>
+	{
+		/** \brief Decimal exponent, below which any value is rounded to zero. */
+		static constexpr int min_power = -65;
+		/** \brief Decimal exponent, above which any value is infinity. */
+		static constexpr int max_power = 38;
+		/** \brief Minimum decimal exponent, at which ties are possible. */
+		static constexpr int min_round_to_even = -17;
+		/** \brief Maximum decimal exponent, at which ties are possible. */
+		static constexpr int max_round_to_even = 10;
+	};
+
+	/** \brief `eisel_lemire_traits` specialization for `double`. */
+	template<> struct eisel_lemire_traits<double>
+	{
+		/** \brief Decimal exponent, below which any value is rounded to zero. */
+		static constexpr int min_power = -342;
+		/** \brief Decimal exponent, above which any value is infinity. */
+		static constexpr int max_power = 308;
+		/** \brief Minimum decimal exponent, at which ties are possible. */
+		static constexpr int min_round_to_even = -4;
+		/** \brief Maximum decimal exponent, at which ties are possible. */
+		static constexpr int max_round_to_even = 23;
+	};
+
+	/** \brief Result structure of `eisel_lemire()`. */
+	template<typename FloatType> struct eisel_lemire_result
+	{
+		/** \brief Calculated (non-negative) floating point value. */
+		FloatType value;
+		/** \brief Status showing possible under- or overflow. */
+		conversion_status status;
+		/** \brief Flag indicating if the value is ensured to be rounded
+		 * correctly.
+		 */
+		bool is_accurate;
+	};
+
+	/** \brief Converts decimal value of \p **w** * 10 ^ \p **q** to the
+	 * nearest floating point value.
+	 *
+	 * Normalized mantissa is multiplied by 128-bit significand of the power
+	 * of ten (see `powers_ten_128`), the lower half of which is involved
+	 * only if the higher 64 bits of the product are not enough to decide
+	 * on rounding. The rare cases, when even 128-bit product is not enough,
+	 * are reported as inaccurate.
+	 *
+	 * \tparam FloatType floating point type to calculate value of.
+	 *
+	 * \param w decimal mantissa value.
+	 * \param q decimal exponent value.
+	 *
+	 * \return `eisel_lemire_result` structure with the results.
+	 */
+	template<typename FloatType> inline eisel_lemire_result<FloatType> eisel_lemire(std::uint64_t w, int q) noexcept
+	{
+		typedef eisel_lemire_traits<FloatType> traits;
+		typedef typename diy_fp<FloatType>::mantissa_storage_type mantissa_storage_type;
+
+		constexpr int mantissa_bit_size(std::numeric_limits<FloatType>::digits - 1);
+		constexpr int exponent_bias(std::numeric_limits<FloatType>::max_exponent - 1);
+		constexpr int infinity_exponent(2 * std::numeric_limits<FloatType>::max_exponent - 1);
+		// one more bit to round and one more for possible leading zero
+		constexpr int result_shift(64 - mantissa_bit_size - 3);
+		constexpr std::uint64_t precision_mask(~std::uint64_t(0) >> (mantissa_bit_size + 3));
+
+		eisel_lemire_result<FloatType> ret;
+		ret.is_accurate = true;
+		ret.status = conversion_status::success;
+
+		if (!w || q < traits::min_power)
+		{
+			ret.value = FloatType(0);
+			ret.status = w ? conversion_status::underflow : conversion_status::success;
+			return ret;
+		}
+
+		if (q > traits::max_power)
+		{
+			ret.value = huge_value<FloatType>();
+			ret.status = conversion_status::overflow;
+			return ret;
+		}
+
+		diy_fp<double> nw(w, 0);
+		nw.normalize();
+		w = nw.mantissa();
+		const int lz(-nw.exponent());
+
+		const std::size_t index(powers_ten_128::pow_0_offset + q);
+		wide_product product(full_multiply(w, powers_ten_128::high[index]));
+
+		if ((product.high & precision_mask) == precision_mask)
+		{
+			const wide_product second(full_multiply(w, powers_ten_128::low[index]));
+			product.low += second.high;
+			product.high += second.high > product.low;
+		}
+
+		// powers of 5 in the range are exact in 128 bits
+		if (product.low == ~std::uint64_t(0) && (q < -27 || q > 55))
+		{
+			ret.is_accurate = false;
+			return ret;
+		}
+
+		const int upper_bit(product.high >> 63);
+		std::uint64_t mantissa(product.high >> (upper_bit + result_shift));
+
+		// log2(10) * q as fixed point value
+		int power2((((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz + exponent_bias);
+
+		if (power2 <= 0) // denormalized value
+		{
+			if (-power2 + 1 >= 64)
+			{
+				ret.value = FloatType(0);
+				ret.status = conversion_status::underflow;
+				return ret;
+			}
+
+			mantissa >>= -power2 + 1;
+			mantissa += mantissa & 1;
+			mantissa >>= 1;
+
+			// rounding up may result in the minimum normalized value
+			power2 = mantissa < (std::uint64_t(1) << mantissa_bit_size) ? 0 : 1;
+		}
+		else
+		{
+			// exact ties are only possible, when 5 ^ q fits 64 bits
+			if (product.low <= 1 && q >= traits::min_round_to_even && q <= traits::max_round_to_even &&
+				(mantissa & 3) == 1 && (mantissa << (upper_bit + result_shift)) == product.high)
+			{
+				mantissa &= ~std::uint64_t(1);
+			}
+
+			mantissa += mantissa & 1;
+			mantissa >>= 1;
+
+			if (mantissa >= (std::uint64_t(2) << mantissa_bit_size))
+			{
+				mantissa = std::uint64_t(1) << mantissa_bit_size;
+				++power2;
+			}
+
+			mantissa &= ~(std::uint64_t(1) << mantissa_bit_size);
+
+			if (power2 >= infinity_exponent)
+			{
+				ret.value = huge_value<FloatType>();
+				ret.status = conversion_status::overflow;
+				return ret;
+			}
+		}
+
+		const std::uint64_t parts(mantissa | (std::uint64_t(power2) << mantissa_bit_size));
+		ret.value = type_punning_cast<FloatType>(mantissa_storage_type(parts));
+
+		if (ret.value == FloatType(0))
+			ret.status = conversion_status::underflow;
+
+		return ret;
+	}
+}
+
+#endif // FLOAXIE_EISEL_LEMIRE_H
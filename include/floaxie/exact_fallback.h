@@ -0,0 +1,351 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_EXACT_FALLBACK_H
+#define FLOAXIE_EXACT_FALLBACK_H
+
+#include <limits>
+#include <cstddef>
+#include <cmath>
+
+#include <floaxie/krosh.h>
+#include <floaxie/big_int.h>
+#include <floaxie/diy_fp.h>
+#include <floaxie/huge_val.h>
+#include <floaxie/type_punning_cast.h>
+#include <floaxie/value_and_status.h>
+#include <floaxie/conversion_status.h>
+
+namespace floaxie
+{
+	/** \brief Maximum number of significant decimal digits taken into
+	 * account by `exact_fallback()`.
+	 *
+	 * Exact midpoint between two adjacent `double` values never has more,
+	 * than 767 significant decimal digits, so the remaining digits only
+	 * matter as a whole, i.e. if any of them is not zero.
+	 */
+	constexpr std::size_t exact_digits(800);
+
+	/** \brief Decimal value of arbitrary precision.
+	 *
+	 * The value is `digits` * 10 ^ `exponent`.
+	 */
+	struct exact_decimal
+	{
+		/** \brief Significant decimal digits of the value. */
+		big_int digits;
+
+		/** \brief Decimal exponent of the value. */
+		int exponent;
+
+		/** \brief Decimal magnitude of the value, i.e. it lays in the
+		 * range of [10 ^ (`magnitude` - 1), 10 ^ `magnitude`).
+		 */
+		int magnitude;
+	};
+
+	/** \brief Reads decimal floating point value representation into
+	 * `exact_decimal` structure.
+	 *
+	 * The representation is expected to be already validated by **Krosh**,
+	 * so only sign, digits, decimal point and exponent are handled here.
+	 *
+	 * If there are more, than `exact_digits`, significant digits, the rest
+	 * of them is replaced by one *sticky* digit, which is `1`, if any of the
+	 * dropped digits is not zero.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) \p **str**
+	 * consists of.
+	 *
+	 * \param str pointer to the beginning of the representation.
+	 * \param str_end pointer to the end of the representation.
+	 *
+	 * \return `exact_decimal` structure with the value.
+	 */
+	template<typename CharType> exact_decimal read_exact_decimal(const CharType* str, const CharType* str_end) noexcept
+	{
+		constexpr unsigned int chunk_size(9);
+		constexpr big_int::limb_type chunk_pows[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+		exact_decimal ret;
+		ret.exponent = 0;
+
+		std::size_t digits_count(0);
+		big_int::limb_type chunk(0);
+		unsigned int chunk_length(0);
+		bool dot_set(false), sticky(false);
+
+		if (str != str_end && (*str == '-' || *str == '+'))
+			++str;
+
+		for (; str != str_end; ++str)
+		{
+			const CharType c(*str);
+
+			if (c == '.')
+			{
+				dot_set = true;
+				continue;
+			}
+
+			if (c < '0' || c > '9')
+				break;
+
+			if (!digits_count && c == '0')
+			{
+				ret.exponent -= dot_set;
+				continue;
+			}
+
+			if (digits_count < exact_digits)
+			{
+				chunk = chunk * 10 + big_int::limb_type(c - '0');
+
+				if (++chunk_length == chunk_size)
+				{
+					ret.digits.multiply_add(chunk_pows[chunk_size], chunk);
+					chunk = 0;
+					chunk_length = 0;
+				}
+
+				++digits_count;
+				ret.exponent -= dot_set;
+			}
+			else
+			{
+				sticky |= c != '0';
+				ret.exponent += !dot_set;
+			}
+		}
+
+		ret.digits.multiply_add(chunk_pows[chunk_length], chunk);
+
+		if (sticky)
+		{
+			ret.digits.multiply_add(10, 1);
+			++digits_count;
+			--ret.exponent;
+		}
+
+		ret.exponent += parse_exponent(str, str_end).value;
+
+		ret.magnitude = int(digits_count) + ret.exponent;
+
+		return ret;
+	}
+
+	/** \brief Compares decimal value with the midpoint between the specified
+	 * floating point value and the next one.
+	 *
+	 * The midpoint is (2 * `f` + 1) * 2 ^ (`e` - 1), where `f` and `e` are
+	 * mantissa and exponent of \p **v**. Both sides are scaled to integers
+	 * and compared exactly.
+	 *
+	 * \return negative value, if \p **dec** is less, than the midpoint, zero,
+	 * if they are equal, positive value otherwise.
+	 */
+	template<typename FloatType> int compare_with_midpoint(const exact_decimal& dec, FloatType v) noexcept
+	{
+		const diy_fp<FloatType> w(v);
+
+		big_int lhs(dec.digits);
+		big_int rhs(2 * std::uint64_t(w.mantissa()) + 1);
+
+		const int bin_exponent(w.exponent() - 1);
+
+		// 10 ^ n = 5 ^ n * 2 ^ n, powers of 2 of both sides are reduced
+		int lhs_shift(0), rhs_shift(0);
+
+		if (dec.exponent >= 0)
+		{
+			lhs.multiply_pow5(dec.exponent);
+			lhs_shift += dec.exponent;
+		}
+		else
+		{
+			rhs.multiply_pow5(-dec.exponent);
+			rhs_shift -= dec.exponent;
+		}
+
+		if (bin_exponent >= 0)
+			rhs_shift += bin_exponent;
+		else
+			lhs_shift -= bin_exponent;
+
+		if (lhs_shift > rhs_shift)
+			lhs.shift_left(lhs_shift - rhs_shift);
+		else
+			rhs.shift_left(rhs_shift - lhs_shift);
+
+		return compare(lhs, rhs);
+	}
+
+	/** \brief Finds correctly rounded floating point value for the decimal
+	 * one, starting from its approximation.
+	 *
+	 * The approximation is moved to the adjacent values, until the decimal
+	 * value lays between the midpoints around it. Ties are rounded to the
+	 * value with even mantissa. It takes one or two steps for approximations
+	 * **Krosh** produces.
+	 *
+	 * \param dec decimal value to convert.
+	 * \param approx non-negative approximation of the result.
+	 *
+	 * \return correctly rounded floating point value (infinity in case of
+	 * overflow).
+	 */
+	template<typename FloatType> FloatType exact_round(const exact_decimal& dec, FloatType approx) noexcept
+	{
+		typedef typename diy_fp<FloatType>::mantissa_storage_type mantissa_storage_type;
+
+		const mantissa_storage_type infinity_bits(type_punning_cast<mantissa_storage_type>(std::numeric_limits<FloatType>::infinity()));
+
+		mantissa_storage_type bits(type_punning_cast<mantissa_storage_type>(approx));
+
+		if (bits >= infinity_bits)
+			bits = infinity_bits - 1;
+
+		for (;;)
+		{
+			const int up(compare_with_midpoint(dec, type_punning_cast<FloatType>(bits)));
+
+			if (up > 0 || (up == 0 && (bits & 1)))
+			{
+				if (++bits == infinity_bits)
+					break;
+
+				continue;
+			}
+
+			if (bits)
+			{
+				const mantissa_storage_type prev_bits(bits - 1);
+				const int down(compare_with_midpoint(dec, type_punning_cast<FloatType>(prev_bits)));
+
+				if (down < 0 || (down == 0 && !(prev_bits & 1)))
+				{
+					bits = prev_bits;
+					continue;
+				}
+			}
+
+			break;
+		}
+
+		return type_punning_cast<FloatType>(bits);
+	}
+
+	/** \brief Refines the result of **Krosh**, if it's not ensured to be
+	 * rounded correctly.
+	 *
+	 * The result is refined by exact comparisons of the input decimal value
+	 * with midpoints between adjacent floating point values by means of
+	 * `big_int` (see `exact_round()`). Only the part of the input, which has
+	 * been parsed by **Krosh**, is read.
+	 *
+	 * \tparam FloatType floating point type to parse.
+	 * \tparam CharType character type of string to parse.
+	 *
+	 * \param str pointer to the beginning of the parsed representation.
+	 * \param cr result of **Krosh** for \p **str**.
+	 *
+	 * \return structure containing the correctly rounded value and status of
+	 * the conversion.
+	 */
+	template<typename FloatType, typename CharType>
+	inline value_and_status<FloatType> exact_refine(const CharType* str, const krosh_result<FloatType, CharType>& cr) noexcept
+	{
+		value_and_status<FloatType> ret;
+
+		ret.value = cr.value;
+		ret.status = cr.status;
+
+		if (cr.is_accurate)
+			return ret;
+
+		const auto& dec(read_exact_decimal(str, cr.str_end));
+		const bool negative(std::signbit(cr.value));
+
+		constexpr int max_magnitude(std::numeric_limits<FloatType>::max_exponent10 + 1);
+
+		FloatType value;
+
+		if (dec.digits.is_zero())
+		{
+			value = FloatType(0);
+			ret.status = conversion_status::success;
+		}
+		else if (dec.magnitude < min_decimal_magnitude<FloatType>)
+		{
+			value = FloatType(0);
+			ret.status = conversion_status::underflow;
+		}
+		else if (dec.magnitude > max_magnitude)
+		{
+			value = huge_value<FloatType>();
+			ret.status = conversion_status::overflow;
+		}
+		else
+		{
+			value = exact_round(dec, std::fabs(cr.value));
+
+			if (value == FloatType(0))
+				ret.status = conversion_status::underflow;
+			else if (value == huge_value<FloatType>())
+				ret.status = conversion_status::overflow;
+			else
+				ret.status = conversion_status::success;
+		}
+
+		ret.value = negative ? -value : value;
+
+		return ret;
+	}
+
+	/** \brief Exact fallback conversion function for `atof()`.
+	 *
+	 * Used by default, when **Krosh** is unsure, if its result is rounded
+	 * correctly. The result of **Krosh** is refined by `exact_refine()`, so
+	 * it's correctly rounded (just like the one of `strtod()` is). In
+	 * contrast to C Standard Library functions, it doesn't depend on current
+	 * locale, doesn't allocate memory and doesn't use `errno`.
+	 *
+	 * \tparam FloatType floating point type to parse.
+	 * \tparam CharType character type of string to parse.
+	 *
+	 * \param str null-terminated buffer containing the string representation
+	 * of the value.
+	 * \param str_end out parameter, which will contain a pointer to first
+	 * character after the parsed value in the specified buffer. If str_end is
+	 * null, it is ignored.
+	 *
+	 * \return structure containing the parsed value and status of the
+	 * conversion made.
+	 */
+	template<typename FloatType, typename CharType>
+	inline value_and_status<FloatType> exact_fallback(const CharType* str, CharType** str_end) noexcept
+	{
+		const auto& cr(krosh<FloatType>(str));
+
+		if (str_end)
+			*str_end = const_cast<CharType*>(cr.str_end);
+
+		return exact_refine(str, cr);
+	}
+}
+
+#endif // FLOAXIE_EXACT_FALLBACK_H
@@ -0,0 +1,161 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * exact_shortest() function implements free-format algorithm by Robert
+ * G. Burger and R. Kent Dybvig, as described in "Printing Floating-Point
+ * Numbers Quickly and Accurately" paper
+ * (https://doi.org/10.1145/231379.231397)
+ */
+
+#ifndef FLOAXIE_EXACT_SHORTEST_H
+#define FLOAXIE_EXACT_SHORTEST_H
+
+#include <limits>
+#include <algorithm>
+#include <cassert>
+
+#include <floaxie/big_int.h>
+#include <floaxie/diy_fp.h>
+#include <floaxie/k_comp.h>
+#include <floaxie/bit_ops.h>
+
+namespace floaxie
+{
+	/** \brief Generates the shortest representation of the value, which is
+	 * the closest to it, by exact calculations.
+	 *
+	 * The value and its boundaries (the midpoints between the value and the
+	 * adjacent ones) are scaled to integers of `big_int` type, so no error is
+	 * ever made. Boundaries are included, if mantissa of the value is even,
+	 * as such decimal values are rounded to it. It is much slower, than
+	 * **Grisu**, so it's only used, when `grisu3()` fails.
+	 *
+	 * \tparam FloatType type of input floating-point value (calculated by type
+	 * of \p **v** parameter).
+	 * \tparam DigitWriter type of digit writer (see `plain_digit_writer`).
+	 *
+	 * \param v positive floating point value to print.
+	 * \param writer digit writer to pass the generated digits to.
+	 * \param K output parameter to return **K** (decimal exponent) of the
+	 * value.
+	 */
+	template<typename FloatType, typename DigitWriter> inline void exact_shortest(FloatType v, DigitWriter& writer, int* K) noexcept
+	{
+		typedef typename diy_fp<FloatType>::mantissa_storage_type mantissa_storage_type;
+
+		constexpr int min_exponent(std::numeric_limits<FloatType>::min_exponent - std::numeric_limits<FloatType>::digits);
+		constexpr mantissa_storage_type hidden_bit(raised_bit<mantissa_storage_type>(std::numeric_limits<FloatType>::digits - 1));
+
+		const diy_fp<FloatType> w(v);
+
+		assert(w.mantissa());
+
+		const bool even(!(w.mantissa() & 1));
+		// the lower boundary is closer at powers of 2 (except the minimum normalized value)
+		const unsigned int lower_closer(w.mantissa() == hidden_bit && w.exponent() > min_exponent);
+
+		// v = r / s, M- = v - m_minus / s, M+ = v + m_plus / s
+		big_int r(w.mantissa()), s(1), m_minus(1);
+
+		r.shift_left(std::max(w.exponent(), 0) + 1 + lower_closer);
+		s.shift_left(std::max(-w.exponent(), 0) + 1 + lower_closer);
+		m_minus.shift_left(std::max(w.exponent(), 0));
+
+		big_int m_plus(m_minus);
+		m_plus.shift_left(lower_closer);
+
+		// 10 ^ (k - 1) <= v, and M+ < 10 ^ (k + 1)
+		int k(floor_log10_pow2(w.exponent() + int(bit_size<mantissa_storage_type>()) - count_leading_zeros(w.mantissa()) - 1) + 1);
+
+		if (k >= 0)
+		{
+			s.multiply_pow10(k);
+		}
+		else
+		{
+			r.multiply_pow10(-k);
+			m_minus.multiply_pow10(-k);
+			m_plus.multiply_pow10(-k);
+		}
+
+		// checks, if the representation rounded up is still in the interval
+		const auto is_high = [even](const big_int& rest, const big_int& margin, const big_int& scale)
+		{
+			big_int high(rest);
+			high.add(margin);
+
+			const int cmp(compare(high, scale));
+			return even ? cmp >= 0 : cmp > 0;
+		};
+
+		if (is_high(r, m_plus, s))
+		{
+			s.multiply_add(10, 0);
+			++k;
+		}
+
+		writer.start(k);
+
+		int length(0);
+
+		for (;;)
+		{
+			r.multiply_add(10, 0);
+			m_minus.multiply_add(10, 0);
+			m_plus.multiply_add(10, 0);
+
+			unsigned char d(0);
+			while (compare(r, s) >= 0)
+			{
+				r.subtract(s);
+				++d;
+			}
+
+			++length;
+
+			const int cmp_low(compare(r, m_minus));
+			const bool low(even ? cmp_low <= 0 : cmp_low < 0);
+			const bool high(is_high(r, m_plus, s));
+
+			if (low || high)
+			{
+				if (low && high)
+				{
+					// both representations are in the interval, the closest is chosen
+					big_int twice_r(r);
+					twice_r.shift_left(1);
+
+					const int cmp(compare(twice_r, s));
+					d += cmp > 0 || (cmp == 0 && (d & 1));
+				}
+				else
+				{
+					d += high;
+				}
+
+				assert(d < 10);
+
+				writer.put(d);
+				break;
+			}
+
+			writer.put(d);
+		}
+
+		*K = k - length;
+	}
+}
+
+#endif // FLOAXIE_EXACT_SHORTEST_H
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_FORMAT_OPTIONS_H
+#define FLOAXIE_FORMAT_OPTIONS_H
+
+#include <cstddef>
+
+namespace floaxie
+{
+	/** \brief Compile-time options of the representation `ftoa()` prints.
+	 *
+	 * The options are the default ones `ftoa()` uses. Other compile-time
+	 * options are defined by deriving from the structure and hiding the
+	 * members to be changed, e.g.:
+	 *
+	 * ```cpp
+	 * struct python_options : default_format_options
+	 * {
+	 *     static constexpr bool exponent_plus = true;
+	 * };
+	 * ```
+	 *
+	 * \see `format_options`
+	 * \see `ftoa_format()`
+	 */
+	struct default_format_options
+	{
+		/** \brief Maximum number of digits in the representation (including
+		 * leading and trailing zeros), when decimal format is used,
+		 * otherwise decimal exponent (a.k.a. *scientific*) format is chosen.
+		 */
+		static constexpr std::size_t scientific_threshold = 16;
+
+		/** \brief Print plus sign in non-negative exponent. */
+		static constexpr bool exponent_plus = false;
+
+		/** \brief Minimum number of exponent digits (from 1 to 3), the
+		 * exponent is padded by leading zeros to.
+		 */
+		static constexpr unsigned int exponent_digits = 2;
+
+		/** \brief Print integral values in decimal format with decimal point
+		 * and zero fractional digit (e.g. "5.0").
+		 */
+		static constexpr bool force_decimal_point = false;
+
+		/** \brief Representation of NaN values. */
+		static constexpr const char* nan = "nan";
+
+		/** \brief Representation of positive infinity. */
+		static constexpr const char* infinity = "inf";
+
+		/** \brief Representation of negative infinity. */
+		static constexpr const char* negative_infinity = "-inf";
+	};
+
+	/** \brief Runtime options of the representation `ftoa_format()` prints.
+	 *
+	 * Has the same members, as `default_format_options` has, and is
+	 * initialized by the same default values.
+	 *
+	 * \see `default_format_options`
+	 */
+	struct format_options
+	{
+		/** \brief See `default_format_options::scientific_threshold`. */
+		std::size_t scientific_threshold = default_format_options::scientific_threshold;
+
+		/** \brief See `default_format_options::exponent_plus`. */
+		bool exponent_plus = default_format_options::exponent_plus;
+
+		/** \brief See `default_format_options::exponent_digits`. */
+		unsigned int exponent_digits = default_format_options::exponent_digits;
+
+		/** \brief See `default_format_options::force_decimal_point`. */
+		bool force_decimal_point = default_format_options::force_decimal_point;
+
+		/** \brief See `default_format_options::nan`. */
+		const char* nan = default_format_options::nan;
+
+		/** \brief See `default_format_options::infinity`. */
+		const char* infinity = default_format_options::infinity;
+
+		/** \brief See `default_format_options::negative_infinity`. */
+		const char* negative_infinity = default_format_options::negative_infinity;
+	};
+}
+
+#endif // FLOAXIE_FORMAT_OPTIONS_H
@@ -18,16 +18,120 @@
 #define FLOAXIE_FTOA_H
 
 #include <string>
+#include <algorithm>
 #include <type_traits>
 #include <cmath>
 #include <cstddef>
 #include <cassert>
 
 #include <floaxie/grisu.h>
+#include <floaxie/exact_shortest.h>
+#include <floaxie/dragonbox.h>
 #include <floaxie/prettify.h>
+#include <floaxie/format_options.h>
+
+#ifndef FLOAXIE_FTOA_ENGINE
+#define FLOAXIE_FTOA_ENGINE grisu2_engine
+#endif
 
 namespace floaxie
 {
+	/** \brief Maximum number of digits in the representation printed by
+	 * `ftoa()`, when decimal format is used, otherwise decimal exponent (a.k.a.
+	 * *scientific*) format is chosen.
+	 */
+	constexpr std::size_t ftoa_scientific_threshold(default_format_options::scientific_threshold);
+
+	/** \brief **Grisu2** digit generation engine for `ftoa()`.
+	 *
+	 * The fastest engine, but the representation it generates, while being
+	 * always rounded to the value correctly, is not the shortest for about
+	 * 1% of values.
+	 */
+	struct grisu2_engine
+	{
+		/** \brief Generates the digits of positive value \p **v** by
+		 * `grisu2()`.
+		 */
+		template<typename FloatType, typename DigitWriter> static void generate(FloatType v, DigitWriter& writer, int* K) noexcept
+		{
+			constexpr int alpha(grisu_parameters<FloatType>.alpha), gamma(grisu_parameters<FloatType>.gamma);
+			grisu2<alpha, gamma>(v, writer, K);
+		}
+	};
+
+	/** \brief **Grisu3** digit generation engine for `ftoa()`.
+	 *
+	 * The representation it generates is always the shortest one and the
+	 * closest to the value among the shortest ones. `exact_shortest()` is
+	 * called for the values `grisu3()` fails to process, so the engine is
+	 * a bit slower, than `grisu2_engine`.
+	 */
+	struct grisu3_engine
+	{
+		/** \brief Generates the digits of positive value \p **v** by
+		 * `grisu3()`, falling back to `exact_shortest()`.
+		 */
+		template<typename FloatType, typename DigitWriter> static void generate(FloatType v, DigitWriter& writer, int* K) noexcept
+		{
+			constexpr int alpha(grisu_parameters<FloatType>.alpha), gamma(grisu_parameters<FloatType>.gamma);
+
+			if (!grisu3<alpha, gamma>(v, writer, K))
+			{
+				writer.reset();
+				exact_shortest(v, writer, K);
+			}
+		}
+	};
+
+	/** \brief **Dragonbox** digit generation engine for `ftoa()`.
+	 *
+	 * The representation it generates is the same as the one of
+	 * `grisu3_engine`, but it never needs a fallback and is usually the
+	 * fastest engine for `double` values.
+	 */
+	struct dragonbox_engine
+	{
+		/** \brief Generates the digits of positive value \p **v** by
+		 * `dragonbox()`.
+		 */
+		template<typename FloatType, typename DigitWriter> static void generate(FloatType v, DigitWriter& writer, int* K) noexcept
+		{
+			constexpr half_of_mantissa_storage_type chunk_pow(static_pow<10, 8>());
+
+			const auto& d(dragonbox(v));
+			const std::uint64_t significand(d.significand);
+
+			// up to 17 digits are passed to the writer as 9 and 8 ones
+			const half_of_mantissa_storage_type high(significand < chunk_pow ? significand : significand / chunk_pow);
+			const unsigned int high_length(calculate_kappa_div(high).first);
+
+			if (high == significand)
+			{
+				writer.start(int(high_length) + d.exponent);
+				writer.put_digits(high, high_length);
+			}
+			else
+			{
+				writer.start(int(high_length) + 8 + d.exponent);
+				writer.put_digits(high, high_length);
+				writer.put_digits(half_of_mantissa_storage_type(significand - std::uint64_t(high) * chunk_pow), 8);
+			}
+
+			*K = d.exponent;
+		}
+	};
+
+	/** \brief Digit generation engine `ftoa()` uses by default.
+	 *
+	 * Set by `FLOAXIE_FTOA_ENGINE` macro to one of `grisu2_engine`,
+	 * `grisu3_engine` or `dragonbox_engine` (`grisu2_engine` by default), so
+	 * that the engine can be chosen for the whole build without changing the
+	 * calls. The macro should have the same value in all the translation
+	 * units of the program.
+	 */
+	typedef FLOAXIE_FTOA_ENGINE default_ftoa_engine;
+
 	/** \brief Returns maximum size of buffer can ever be required by `ftoa()`.
 	 *
 	 * Maximum size of buffer passed to `ftoa()` guaranteed not to lead to
@@ -47,6 +151,111 @@ namespace floaxie
 		return max_digits<FloatType>() + 1 + 1 + 3 + 1;
 	}
 
+	/** \brief Returns maximum size of buffer can ever be required by
+	 * `ftoa_format()` with the specified options.
+	 *
+	 * \tparam FloatType floating point type, which value is planned to be
+	 * printed to the buffer.
+	 * \tparam Options format options type (calculated by type of \p
+	 * **options** parameter).
+	 *
+	 * \param options format options to be used.
+	 */
+	template<typename ValueType, typename Options> inline std::size_t max_buffer_size(const Options& options) noexcept
+	{
+		const std::size_t threshold(options.scientific_threshold);
+
+		// the same as for ftoa() plus exponent sign, or sign, all the digits
+		// of decimal format, "0." or ".0" and '\0'
+		const std::size_t numeric(std::max(max_buffer_size<ValueType>() + 1, 1 + threshold + 2 + 1));
+
+		const std::size_t special(std::max({ std::char_traits<char>::length(options.nan),
+			std::char_traits<char>::length(options.infinity),
+			std::char_traits<char>::length(options.negative_infinity) }) + 1);
+
+		return std::max(numeric, special);
+	}
+
+	/** \brief Copies null-terminated string (without the null character).
+	 *
+	 * \return number of characters written.
+	 */
+	template<typename CharType> inline std::size_t print_string(const char* str, CharType* buffer) noexcept
+	{
+		std::size_t length(0);
+
+		while (str[length])
+		{
+			buffer[length] = str[length];
+			++length;
+		}
+
+		return length;
+	}
+
+	/** \brief Prints special (NaN, infinite or zero) floating point value.
+	 *
+	 * \return number of characters written (no terminating null character is
+	 * written).
+	 */
+	template<typename FloatType, typename CharType, typename Options = default_format_options>
+	inline std::size_t print_special(FloatType v, CharType* buffer, const Options& options = Options()) noexcept
+	{
+		if (std::isnan(v))
+		{
+			return print_string(options.nan, buffer);
+		}
+		else if (std::isinf(v))
+		{
+			return print_string(v < 0 ? options.negative_infinity : options.infinity, buffer);
+		}
+		else
+		{
+			buffer[0] = '0';
+
+			if (options.force_decimal_point)
+			{
+				buffer[1] = '.';
+				buffer[2] = '0';
+
+				return 3;
+			}
+
+			return 1;
+		}
+	}
+
+	/** \brief Prints finite non-zero floating point value.
+	 *
+	 * \return number of characters written (no terminating null character is
+	 * written).
+	 */
+	template<typename Engine, typename FloatType, typename CharType, typename Options = default_format_options>
+	inline std::size_t print_regular(FloatType v, CharType* buffer, const Options& options = Options()) noexcept
+	{
+		*buffer = '-';
+		buffer += v < 0;
+
+		layout_digit_writer<Options, CharType> writer(buffer, options);
+		int K;
+
+		Engine::generate(std::fabs(v), writer, &K);
+		return (v < 0) + writer.finish(K);
+	}
+
+	/** \brief Prints floating point value the way `ftoa()` (or
+	 * `ftoa_format()`, if the options are specified) does, but without
+	 * terminating null character.
+	 *
+	 * \return number of characters written.
+	 */
+	template<typename Engine = default_ftoa_engine, typename FloatType, typename CharType, typename Options = default_format_options>
+	inline std::size_t print_value(FloatType v, CharType* buffer, const Options& options = Options()) noexcept
+	{
+		// the only check for the most common case of regular values
+		return std::isfinite(v) && v != 0 ? print_regular<Engine>(v, buffer, options) : print_special(v, buffer, options);
+	}
+
 	/** \brief Prints floating point value to optimal string representation.
 	 *
 	 * The function prints the string representation of the specified floating
@@ -55,9 +264,9 @@ namespace floaxie
 	 * algorithm and tries to get it as shorter, as possible. Usually it
 	 * succeeds, but sometimes fails, and the output representation is not
 	 * the shortest for this value. For the sake of speed improvement this is
-	 * ignored, while there's **Grisu3** algorithm which rules this out
-	 * informing the caller of the failure, so that it can call slower, but
-	 * more accurate algorithm in this case.
+	 * ignored by default, while `grisu3_engine` can be passed to use
+	 * **Grisu3** algorithm, which detects such cases, so that slower, but
+	 * exact algorithm is called for them.
 	 *
 	 * The format of the string representation is one of the following:
 	 * 1. Decimal notation, which contains:
@@ -76,68 +285,196 @@ namespace floaxie
 	 * input parameter \p **v**.
 	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
 	 * output buffer \p **buffer**.
+	 * \tparam Engine digit generation engine (`grisu2_engine`,
+	 * `grisu3_engine` or `dragonbox_engine`).
 	 *
 	 * \param v floating point value to print.
 	 * \param buffer character buffer of enough size (see `max_buffer_size()`)
 	 * to print the representation to.
+	 * \param engine digit generation engine. If omitted,
+	 * `default_ftoa_engine` is used, which is `grisu2_engine` unless
+	 * `FLOAXIE_FTOA_ENGINE` is defined. `grisu3_engine` and
+	 * `dragonbox_engine` always print the shortest representation.
 	 *
 	 * \return number of characters actually written.
 	 *
 	 * \see `max_buffer_size()`
 	 */
-	template<typename FloatType, typename CharType> inline std::size_t ftoa(FloatType v, CharType* buffer) noexcept
+	template<typename FloatType, typename CharType, typename Engine = default_ftoa_engine>
+	inline std::size_t ftoa(FloatType v, CharType* buffer, Engine engine = Engine()) noexcept
 	{
-		if (std::isnan(v))
-		{
-			buffer[0] = 'n';
-			buffer[1] = 'a';
-			buffer[2] = 'n';
-			buffer[3] = '\0';
+		static_cast<void>(engine);
 
-			return 3;
-		}
-		else if (std::isinf(v))
-		{
-			if (v > 0)
-			{
-				buffer[0] = 'i';
-				buffer[1] = 'n';
-				buffer[2] = 'f';
-				buffer[3] = '\0';
+		const std::size_t length(print_value<Engine>(v, buffer));
+		buffer[length] = '\0';
 
-				return 3;
-			}
-			else
-			{
-				buffer[0] = '-';
-				buffer[1] = 'i';
-				buffer[2] = 'n';
-				buffer[3] = 'f';
-				buffer[4] = '\0';
+		return length;
+	}
 
-				return 4;
-			}
+	/** \brief Prints floating point value to optimal string representation
+	 * in the format specified by the options.
+	 *
+	 * The representation is the same as the one `ftoa()` prints, but the
+	 * threshold of decimal exponent format, the style of exponent, the
+	 * representations of special values and the presence of decimal point
+	 * in integral values are specified by \p **options**, so that no
+	 * post-processing of the representation is needed. The options can be
+	 * either compile-time (`default_format_options` or a structure derived
+	 * from it) or runtime ones (`format_options`).
+	 *
+	 * \tparam FloatType type of floating point value, calculated using passed
+	 * input parameter \p **v**.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer \p **buffer**.
+	 * \tparam Options format options type (calculated by type of \p
+	 * **options** parameter).
+	 * \tparam Engine digit generation engine.
+	 *
+	 * \param v floating point value to print.
+	 * \param buffer character buffer of enough size (see `max_buffer_size()`
+	 * overload accepting the options) to print the representation to.
+	 * \param options format options to use.
+	 * \param engine digit generation engine (see `ftoa()`).
+	 *
+	 * \return number of characters actually written.
+	 *
+	 * \see `ftoa()`
+	 * \see `default_format_options`
+	 * \see `format_options`
+	 */
+	template<typename FloatType, typename CharType, typename Options, typename Engine = default_ftoa_engine>
+	inline std::size_t ftoa_format(FloatType v, CharType* buffer, const Options& options, Engine engine = Engine()) noexcept
+	{
+		static_cast<void>(engine);
+
+		const std::size_t length(print_value<Engine>(v, buffer, options));
+		buffer[length] = '\0';
+
+		return length;
+	}
+
+	/** \brief Prints array of floating point values to one contiguous buffer,
+	 * separating them by the specified character.
+	 *
+	 * The representations are the same as the ones `ftoa()` prints, but no
+	 * terminating null characters are written at all, so the values are
+	 * printed one right after another, only separated by \p **sep**.
+	 *
+	 * \tparam FloatType type of floating point values to print.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer \p **out**.
+	 * \tparam Engine digit generation engine.
+	 *
+	 * \param first pointer to the first value to print.
+	 * \param last pointer to the element after the last value to print.
+	 * \param out character buffer of enough size to print the representations
+	 * to. `max_buffer_size()` characters per value are always enough.
+	 * \param sep separator character to put between the values.
+	 * \param engine digit generation engine (see `ftoa()`).
+	 *
+	 * \return pointer to the character after the last printed one.
+	 *
+	 * \see `ftoa()`
+	 * \see `max_buffer_size()`
+	 */
+	template<typename FloatType, typename CharType, typename Engine = default_ftoa_engine>
+	inline CharType* ftoa_many(const FloatType* first, const FloatType* last, CharType* out, CharType sep, Engine engine = Engine()) noexcept
+	{
+		static_cast<void>(engine);
+
+		if (first == last)
+			return out;
+
+		out += print_value<Engine>(*first, out);
+
+		while (++first != last)
+		{
+			*out++ = sep;
+			out += print_value<Engine>(*first, out);
 		}
-		else if (v == 0)
+
+		return out;
+	}
+
+	/** \brief Calculates the number of characters `ftoa()` prints for the
+	 * value (not counting terminating null character).
+	 *
+	 * The digits are generated the same way, as `ftoa()` does, but they are
+	 * only counted and not written anywhere (see `counting_digit_writer`), so
+	 * the calculation is faster, than printing, and no buffer is needed.
+	 *
+	 * \tparam FloatType type of floating point value, calculated using passed
+	 * input parameter \p **v**.
+	 * \tparam Engine digit generation engine.
+	 *
+	 * \param v floating point value to calculate the length for.
+	 * \param engine digit generation engine (should be the same as the one
+	 * passed to `ftoa()`).
+	 *
+	 * \return number of characters `ftoa()` prints.
+	 */
+	template<typename FloatType, typename Engine = default_ftoa_engine>
+	inline std::size_t ftoa_length(FloatType v, Engine engine = Engine()) noexcept
+	{
+		static_cast<void>(engine);
+
+		if (std::isfinite(v) && v != 0)
 		{
-			buffer[0] = '0';
-			buffer[1] = '\0';
+			counting_digit_writer writer;
+			int K;
 
-			return 1;
+			Engine::generate(std::fabs(v), writer, &K);
+
+			const unsigned int len(writer.length());
+			return (v < 0) + format_length(len, K, choose_format<ftoa_scientific_threshold>(len, K));
 		}
-		else
-		{
-			*buffer = '-';
-			buffer += v < 0;
 
-			constexpr int alpha(grisu_parameters<FloatType>.alpha), gamma(grisu_parameters<FloatType>.gamma);
-			constexpr unsigned int decimal_scientific_threshold(16);
+		// "nan", "inf", "-inf" or "0"
+		return std::isnan(v) ? 3 : std::isinf(v) ? 3 + (v < 0) : 1;
+	}
+
+	/** \brief Calculates the number of characters `ftoa_many()` prints for
+	 * array of floating point values.
+	 *
+	 * Optionally stores the number of characters of each value, so that the
+	 * output buffer can be allocated once and the values can be printed to
+	 * their known offsets independently.
+	 *
+	 * \tparam FloatType type of floating point values.
+	 * \tparam Engine digit generation engine.
+	 *
+	 * \param first pointer to the first value.
+	 * \param last pointer to the element after the last value.
+	 * \param lengths pointer to array of `last` - `first` elements to store
+	 * the number of characters of each value (as `ftoa_length()` returns)
+	 * to. Nothing is stored, if it's null.
+	 * \param engine digit generation engine (should be the same as the one
+	 * passed to `ftoa_many()`).
+	 *
+	 * \return number of characters `ftoa_many()` prints (including the
+	 * separators).
+	 *
+	 * \see `ftoa_length()`
+	 */
+	template<typename FloatType, typename Engine = default_ftoa_engine>
+	inline std::size_t ftoa_many_length(const FloatType* first, const FloatType* last, std::size_t* lengths = nullptr, Engine engine = Engine()) noexcept
+	{
+		if (first == last)
+			return 0;
 
-			int len, K;
+		// separators
+		std::size_t total(last - first - 1);
 
-			grisu2<alpha, gamma>(v, buffer, &len, &K);
-			return (v < 0) + prettify<decimal_scientific_threshold>(buffer, len, K);
+		for (; first != last; ++first)
+		{
+			const std::size_t length(ftoa_length(*first, engine));
+			total += length;
+
+			if (lengths)
+				*lengths++ = length;
 		}
+
+		return total;
 	}
 
 	/** \brief Prints floating point value to optimal representation in
@@ -39,7 +39,7 @@
 #include <floaxie/static_pow.h>
 #include <floaxie/integer_of_size.h>
 #include <floaxie/bit_ops.h>
-#include <floaxie/memwrap.h>
+#include <floaxie/digits_lut.h>
 
 namespace floaxie
 {
@@ -110,18 +110,17 @@ namespace floaxie
 		 *
 		 * \tparam FloatType floating point type of `diy_fp` (`float` for single precision,
 		 * `double` for double precision) of \p **Mm** and \p **Mp**.
-		 * \tparam CharType character type (typically `char` or `wchar_t`) of \p **buffer**.
+		 * \tparam DigitWriter type of digit writer (see `plain_digit_writer`).
 		 *
-		 * \param buffer - buffer where digits are generated to.
-		 * \param len - output parameter to pass the length of the digit sequence written.
+		 * \param writer - digit writer to pass the generated digits to.
 		 * \param K - input/output parameter to reflect K modifications made.
 		 *
 		 * \see [Printing Floating-Point Numbers Quickly and Accurately with
 		 * Integers]
 		 * (http://florian.loitsch.com/publications/dtoa-pldi2010.pdf)
 		 */
-		template<typename FloatType, typename CharType>
-		inline static void gen(const diy_fp<FloatType>& Mp, const diy_fp<FloatType>& Mm, CharType* buffer, int* len, int* K) noexcept
+		template<typename FloatType, typename DigitWriter>
+		inline static void gen(const diy_fp<FloatType>& Mp, const diy_fp<FloatType>& Mm, DigitWriter& writer, int* K) noexcept
 		{
 			assert(Mp.exponent() <= 0);
 
@@ -134,42 +133,33 @@ namespace floaxie
 
 			assert(p1 || p2);
 
-			*len = 0;
-
 			auto delta_f = delta.mantissa();
 
 			const bool close_to_delta = p2 <= delta_f;
 
 			if (p1)
 			{
-				auto&& kappa_div(calculate_kappa_div(p1));
-
-				unsigned char& kappa(kappa_div.first);
-				half_of_mantissa_storage_type& div(kappa_div.second);
+				unsigned char kappa(calculate_kappa_div(p1).first);
 
-				while (kappa > 0 && p1)
+				if (close_to_delta)
 				{
-					buffer[(*len)++] = '0' + p1 / div;
-
-					p1 %= div;
-
-					kappa--;
-					div /= 10;
+					// trailing zeros go to the exponent
+					while (p1 % 10 == 0)
+					{
+						p1 /= 10;
+						--kappa;
+						++(*K);
+					}
 				}
 
+				writer.start(kappa + *K);
+				writer.put_digits(p1, kappa);
+
 				if (close_to_delta)
-				{
-					*K += kappa;
 					return;
-				}
-				else
-				{
-					wrap::memset(buffer + (*len), CharType('0'), kappa);
-					(*len) += kappa;
-				}
 			}
 
-			const bool some_already_written = (*len) > 0;
+			bool started(p1 != 0);
 			unsigned char kappa(0);
 
 			while (p2 > delta_f)
@@ -178,12 +168,21 @@ namespace floaxie
 
 				const unsigned char d = p2 >> -one.exponent();
 
-				if (some_already_written || d)
-					buffer[(*len)++] = '0' + d;
+				++kappa;
+
+				if (started || d)
+				{
+					if (!started)
+					{
+						writer.start(*K - kappa + 1);
+						started = true;
+					}
+
+					writer.put(d);
+				}
 
 				p2 &= one.mantissa() - 1;
 
-				++kappa;
 				delta_f *= 10;
 			}
 
@@ -191,6 +190,114 @@ namespace floaxie
 		}
 	};
 
+	/** \brief Digit writer, which just writes the generated digits to the
+	 * buffer one after another.
+	 *
+	 * Digit writers receive digits from `digit_gen()` and can lay them out
+	 * the desired way. Before the first digit, `start()` is called with the
+	 * decimal point position relative to it (i.e. the value lays in the
+	 * range of [10 ^ (`dot_pos` - 1), 10 ^ `dot_pos`)), then the digits are
+	 * passed by `put()` one by one and by `put_digits()` several at once.
+	 * `decrement_last()` corrects the last digit written (see `grisu3()`),
+	 * while `reset()` discards all the digits to start over.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer.
+	 */
+	template<typename CharType> class plain_digit_writer
+	{
+	public:
+		/** \brief Constructs writer to the specified buffer. */
+		explicit plain_digit_writer(CharType* buffer) noexcept : m_buffer(buffer), m_length(0) { }
+
+		/** \brief Starts writing the digits, ignoring decimal point position. */
+		void start(int) noexcept { }
+
+		/** \brief Writes one digit. */
+		void put(unsigned char d) noexcept
+		{
+			m_buffer[m_length++] = CharType('0' + d);
+		}
+
+		/** \brief Writes \p **count** digits of \p **value** (see
+		 * `print_digits()`).
+		 */
+		void put_digits(half_of_mantissa_storage_type value, unsigned int count) noexcept
+		{
+			print_digits(m_buffer + m_length, value, count);
+			m_length += count;
+		}
+
+		/** \brief Decrements the last digit written. */
+		void decrement_last() noexcept
+		{
+			--m_buffer[m_length - 1];
+		}
+
+		/** \brief Discards all the digits written. */
+		void reset() noexcept
+		{
+			m_length = 0;
+		}
+
+		/** \brief Returns number of digits written. */
+		int length() const noexcept
+		{
+			return m_length;
+		}
+
+	private:
+		CharType* m_buffer;
+		int m_length;
+	};
+
+	/** \brief Digit writer (see `plain_digit_writer`), which doesn't write
+	 * the digits anywhere, but only counts them.
+	 *
+	 * Used to calculate the length of the representation without printing
+	 * it (see `ftoa_length()`).
+	 */
+	class counting_digit_writer
+	{
+	public:
+		/** \brief Constructs writer with no digits counted. */
+		counting_digit_writer() noexcept : m_length(0) { }
+
+		/** \brief Starts counting the digits, ignoring decimal point
+		 * position.
+		 */
+		void start(int) noexcept { }
+
+		/** \brief Counts one digit. */
+		void put(unsigned char) noexcept
+		{
+			++m_length;
+		}
+
+		/** \brief Counts \p **count** digits. */
+		void put_digits(half_of_mantissa_storage_type, unsigned int count) noexcept
+		{
+			m_length += count;
+		}
+
+		/** \brief Does nothing, as the digits are not stored. */
+		void decrement_last() noexcept { }
+
+		/** \brief Discards all the digits counted. */
+		void reset() noexcept
+		{
+			m_length = 0;
+		}
+
+		/** \brief Returns number of digits counted. */
+		int length() const noexcept
+		{
+			return m_length;
+		}
+
+	private:
+		int m_length;
+	};
 
 	/** \brief Digit generation function template.
 	 *
@@ -207,14 +314,11 @@ namespace floaxie
 	 *
 	 * \tparam alpha α value of **Grisu** algorithm.
 	 * \tparam gamma γ value of **Grisu** algorithm.
-	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
-	 * output buffer \p **buffer**.
+	 * \tparam DigitWriter type of digit writer (see `plain_digit_writer`).
 	 *
 	 * \param Mp **M+** value (right boundary).
 	 * \param Mm **M-** value (left boundary).
-	 * \param buffer character buffer to print the representation to
-	 * \param len output parameter to return the length of the representation
-	 * printed.
+	 * \param writer digit writer to pass the generated digits to.
 	 * \param K output parameter to return **K** (decimal exponent) of the
 	 * value.
 	 *
@@ -225,8 +329,8 @@ namespace floaxie
 	 * (http://florian.loitsch.com/publications/dtoa-pldi2010.pdf)
 	 */
 	template<int alpha, int gamma,
-	typename FloatType, typename CharType>
-	inline void digit_gen(const diy_fp<FloatType>& Mp, const diy_fp<FloatType>& Mm, CharType* buffer, int* len, int* K) noexcept
+	typename FloatType, typename DigitWriter>
+	inline void digit_gen(const diy_fp<FloatType>& Mp, const diy_fp<FloatType>& Mm, DigitWriter& writer, int* K) noexcept
 	{
 		static_assert(static_cast<std::size_t>(constexpr_abs(alpha)) >= bit_size<typename diy_fp<FloatType>::mantissa_storage_type>() / 2 &&
 			static_cast<std::size_t>(constexpr_abs(gamma)) >= bit_size<typename diy_fp<FloatType>::mantissa_storage_type>() / 2,
@@ -234,10 +338,52 @@ namespace floaxie
 			"than a half of integer mantissa bit size (typically 32) for performance reasons.");
 
 		constexpr bool exponent_is_positive = alpha > 0 && gamma > 0;
-		digit_gen_select<exponent_is_positive>::gen(Mp, Mm, buffer, len, K);
+		digit_gen_select<exponent_is_positive>::gen(Mp, Mm, writer, K);
 	}
 
 	/** \brief **Grisu2** algorithm implementation.
+	 *
+	 * \tparam alpha α value of **Grisu** algorithm.
+	 * \tparam gamma γ value of **Grisu** algorithm.
+	 * \tparam FloatType type of input floating-point value (calculated by type
+	 * of \p **v** parameter).
+	 * \tparam DigitWriter type of digit writer (see `plain_digit_writer`).
+	 *
+	 * \param v floating point value to print.
+	 * \param writer digit writer to pass the generated digits to.
+	 * \param K output parameter to return **K** (decimal exponent) of the
+	 * value.
+	 *
+	 * \see `max_digits()`
+	 * \see [Printing Floating-Point Numbers Quickly and Accurately with
+	 * Integers]
+	 * (http://florian.loitsch.com/publications/dtoa-pldi2010.pdf)
+	 */
+	template<int alpha, int gamma,
+	typename FloatType, typename DigitWriter> inline void grisu2(FloatType v, DigitWriter& writer, int* K) noexcept
+	{
+		static_assert(alpha <= gamma - 3,
+			"It's imposed that γ ⩾ α + 3, since otherwise it's not always possible to find a proper decimal cached power");
+
+		std::pair<diy_fp<FloatType>, diy_fp<FloatType>>&& w(diy_fp<FloatType>::boundaries(v));
+		diy_fp<FloatType> &w_m(w.first), &w_p(w.second);
+
+		const int mk = k_comp_exp<alpha, gamma>(w_p.exponent());
+		const diy_fp<FloatType>& c_mk(cached_power<FloatType>(mk));
+
+		w_m *= c_mk;
+		w_p *= c_mk;
+
+		++w_m;
+		--w_p;
+
+		*K = -mk;
+
+		digit_gen<alpha, gamma>(w_p, w_m, writer, K);
+	}
+
+	/** \brief **Grisu2** algorithm implementation, writing plain digits to
+	 * the buffer.
 	 *
 	 * \tparam alpha α value of **Grisu** algorithm.
 	 * \tparam gamma γ value of **Grisu** algorithm.
@@ -255,31 +401,198 @@ namespace floaxie
 	 *
 	 * \see `max_digits()`
 	 * \see `max_buffer_size()`
+	 */
+	template<int alpha, int gamma,
+	typename FloatType, typename CharType> inline void grisu2(FloatType v, CharType* buffer, int* length, int* K) noexcept
+	{
+		plain_digit_writer<CharType> writer(buffer);
+		grisu2<alpha, gamma>(v, writer, K);
+		*length = writer.length();
+	}
+
+	/** \brief Corrects the last digit generated by **Grisu3** to get closer
+	 * to the value and checks, if the result is ensured to be the closest
+	 * shortest representation.
+	 *
+	 * All the parameters are expressed in the same units, which are the
+	 * ones of the scaled boundaries, multiplied by \p **unit**.
+	 *
+	 * \param writer digit writer the digits have been passed to.
+	 * \param distance_too_high_w distance between the upper bound of the
+	 * unsafe interval and the scaled value.
+	 * \param unsafe_interval width of the unsafe interval.
+	 * \param rest distance between the upper bound of the unsafe interval and
+	 * the generated representation.
+	 * \param ten_kappa weight of the last generated digit.
+	 * \param unit maximum error of the scaled values.
+	 *
+	 * \return `true`, if the representation is ensured to be correct.
+	 *
+	 * \see [Printing Floating-Point Numbers Quickly and Accurately with
+	 * Integers]
+	 * (http://florian.loitsch.com/publications/dtoa-pldi2010.pdf)
+	 */
+	template<typename MantissaType, typename DigitWriter>
+	inline bool round_weed(DigitWriter& writer, const MantissaType distance_too_high_w, const MantissaType unsafe_interval, MantissaType rest, const MantissaType ten_kappa, const MantissaType unit) noexcept
+	{
+		const MantissaType small_distance(distance_too_high_w - unit);
+		const MantissaType big_distance(distance_too_high_w + unit);
+
+		// the representation is moved down, while it gets closer to the value
+		while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+			(rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance))
+		{
+			writer.decrement_last();
+			rest += ten_kappa;
+		}
+
+		// the closest representation can't be chosen because of the error
+		if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+			(rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance))
+		{
+			return false;
+		}
+
+		return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+	}
+
+	/** \brief Digit generation function of **Grisu3** algorithm.
+	 *
+	 * In contrast to `digit_gen()` of **Grisu2**, the digits are generated
+	 * for the *unsafe* interval, i.e. the one widened by the maximum error of
+	 * the scaled boundaries, and then are checked by `round_weed()` to be
+	 * the shortest and the closest to the value.
+	 *
+	 * \param low scaled lower boundary (**M-**).
+	 * \param w scaled value.
+	 * \param high scaled upper boundary (**M+**).
+	 * \param writer digit writer to pass the generated digits to.
+	 * \param K input/output parameter to reflect K modifications made.
+	 *
+	 * \return `true`, if the generated representation is ensured to be the
+	 * shortest and the closest to the value.
+	 */
+	template<typename FloatType, typename DigitWriter>
+	inline bool digit_gen3(const diy_fp<FloatType>& low, const diy_fp<FloatType>& w, const diy_fp<FloatType>& high, DigitWriter& writer, int* K) noexcept
+	{
+		typedef typename diy_fp<FloatType>::mantissa_storage_type mantissa_storage_type;
+
+		assert(w.exponent() < 0 && low.exponent() == w.exponent() && high.exponent() == w.exponent());
+
+		mantissa_storage_type unit(1);
+		const diy_fp<FloatType> too_low(low.mantissa() - unit, low.exponent());
+		const diy_fp<FloatType> too_high(high.mantissa() + unit, high.exponent());
+
+		mantissa_storage_type unsafe_interval((too_high - too_low).mantissa());
+
+		const diy_fp<FloatType> one(raised_bit<mantissa_storage_type>(-w.exponent()), w.exponent());
+
+		half_of_mantissa_storage_type p1 = too_high.mantissa() >> -one.exponent();
+		mantissa_storage_type p2 = too_high.mantissa() & (one.mantissa() - 1);
+
+		assert(p1);
+
+		int kappa(calculate_kappa_div(p1).first);
+
+		// integral part is wider, than the interval (except for denormalized
+		// values of a few significant bits, which are left to the exact
+		// algorithm), so the digits can end within the interval only after
+		// the last non-zero integral digit
+		if (unsafe_interval >= one.mantissa())
+			return false;
+
+		if (p2 < unsafe_interval)
+		{
+			mantissa_storage_type ten_kappa(one.mantissa());
+
+			while (p1 % 10 == 0)
+			{
+				p1 /= 10;
+				ten_kappa *= 10;
+				--kappa;
+				++(*K);
+			}
+
+			writer.start(kappa + *K);
+			writer.put_digits(p1, kappa);
+
+			return round_weed(writer, (too_high - w).mantissa(), unsafe_interval, p2, ten_kappa, unit);
+		}
+
+		writer.start(kappa + *K);
+		writer.put_digits(p1, kappa);
+
+		kappa = 0;
+
+		for (;;)
+		{
+			p2 *= 10;
+			unit *= 10;
+			unsafe_interval *= 10;
+
+			writer.put(static_cast<unsigned char>(p2 >> -one.exponent()));
+			p2 &= one.mantissa() - 1;
+			--kappa;
+
+			if (p2 < unsafe_interval)
+			{
+				*K += kappa;
+				return round_weed(writer, (too_high - w).mantissa() * unit, unsafe_interval, p2, one.mantissa(), unit);
+			}
+		}
+	}
+
+	/** \brief **Grisu3** algorithm implementation.
+	 *
+	 * Unlike **Grisu2**, it either generates the shortest representation,
+	 * which is the closest to the value, or reports the failure, which
+	 * happens for about 0.5% of `double` values (and about 4% of `float`
+	 * ones, as there are less spare bits in their `diy_fp` mantissa). The
+	 * representation written is undefined then, so the digits should be
+	 * regenerated by some exact algorithm (see `exact_shortest()`).
+	 *
+	 * \tparam alpha α value of **Grisu** algorithm.
+	 * \tparam gamma γ value of **Grisu** algorithm.
+	 * \tparam FloatType type of input floating-point value (calculated by type
+	 * of \p **v** parameter).
+	 * \tparam DigitWriter type of digit writer (see `plain_digit_writer`).
+	 *
+	 * \param v positive floating point value to print.
+	 * \param writer digit writer to pass the generated digits to.
+	 * \param K output parameter to return **K** (decimal exponent) of the
+	 * value.
+	 *
+	 * \return `true`, if the representation is ensured to be the shortest
+	 * and the closest to the value.
+	 *
 	 * \see [Printing Floating-Point Numbers Quickly and Accurately with
 	 * Integers]
 	 * (http://florian.loitsch.com/publications/dtoa-pldi2010.pdf)
 	 */
 	template<int alpha, int gamma,
-	typename FloatType, typename CharType> inline void grisu2(FloatType v, CharType* buffer, int* length, int* K) noexcept
+	typename FloatType, typename DigitWriter> inline bool grisu3(FloatType v, DigitWriter& writer, int* K) noexcept
 	{
 		static_assert(alpha <= gamma - 3,
 			"It's imposed that γ ⩾ α + 3, since otherwise it's not always possible to find a proper decimal cached power");
+		static_assert(gamma < 0, "Only negative α and γ are supported by Grisu3 implementation");
 
-		std::pair<diy_fp<FloatType>, diy_fp<FloatType>>&& w(diy_fp<FloatType>::boundaries(v));
-		diy_fp<FloatType> &w_m(w.first), &w_p(w.second);
+		std::pair<diy_fp<FloatType>, diy_fp<FloatType>>&& b(diy_fp<FloatType>::boundaries(v));
+		diy_fp<FloatType> &w_m(b.first), &w_p(b.second);
+
+		// the value itself with the same exponent as the boundaries
+		const diy_fp<FloatType> d(v);
+		diy_fp<FloatType> w(d.mantissa() << (d.exponent() - w_p.exponent()), w_p.exponent());
 
 		const int mk = k_comp_exp<alpha, gamma>(w_p.exponent());
 		const diy_fp<FloatType>& c_mk(cached_power<FloatType>(mk));
 
 		w_m *= c_mk;
+		w *= c_mk;
 		w_p *= c_mk;
 
-		++w_m;
-		--w_p;
-
 		*K = -mk;
 
-		digit_gen<alpha, gamma>(w_p, w_m, buffer, length, K);
+		return digit_gen3(w_m, w, w_p, writer, K);
 	}
 
 	/** \brief Structure to hold Grisu algorithm parameters, **α** and **γ**. */
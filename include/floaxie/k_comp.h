@@ -24,8 +24,43 @@
 
 namespace floaxie
 {
-	/** \brief Compiled value of \f$log{10} 2 \f$ */
-	constexpr auto lg_2(0.30102999566398114); // 1 / log2(10) = lg(2) ≈ 0.30102999566398114
+	/** \brief Calculates \f$\lfloor n \cdot log{10} 2 \rfloor\f$ by
+	 * integer arithmetic only.
+	 *
+	 * \f$log{10} 2\f$ is approximated by 315653 / 2 ^ 20 fixed point value,
+	 * which gives exact results for |\p **n**| ⩽ 2620.
+	 *
+	 * \param n the power of 2.
+	 */
+	constexpr int floor_log10_pow2(int n) noexcept
+	{
+		return (n * 315653) >> 20;
+	}
+
+	/** \brief Calculates \f$\lfloor n \cdot log{2} 10 \rfloor\f$ by
+	 * integer arithmetic only.
+	 *
+	 * \f$log{2} 10\f$ is approximated by 1741647 / 2 ^ 19 fixed point value,
+	 * which gives exact results for |\p **n**| ⩽ 1233.
+	 *
+	 * \param n the power of 10.
+	 */
+	constexpr int floor_log2_pow10(int n) noexcept
+	{
+		return (n * 1741647) >> 19;
+	}
+
+	/** \brief Calculates \f$\lfloor n \cdot log{10} 2 - log{10} \frac{4}{3}
+	 * \rfloor\f$ by integer arithmetic only.
+	 *
+	 * The result is exact for |\p **n**| ⩽ 2936.
+	 *
+	 * \param n the power of 2.
+	 */
+	constexpr int floor_log10_pow2_minus_log10_4_over_3(int n) noexcept
+	{
+		return (n * 631305 - 261663) >> 21;
+	}
 
 	/** \brief Calculate **K** decimal exponent value by binary exponent.
 	 *
@@ -36,6 +71,10 @@ namespace floaxie
 	 * k_comp() function from reference paper where this component
 	 * is considered.
 	 *
+	 * The value is \f$\lceil (\alpha - e - 1) \cdot log{10} 2 \rceil\f$
+	 * calculated by integer arithmetic only (see `floor_log10_pow2()`), as the
+	 * product is never integer, unless it's zero.
+	 *
 	 * \tparam alpha α value of **Grisu** algorithm.
 	 * \tparam gamma γ value of **Grisu** algorithm.
 	 *
@@ -45,9 +84,9 @@ namespace floaxie
 	 * Integers]
 	 * (http://florian.loitsch.com/publications/dtoa-pldi2010.pdf)
 	 */
-	template<int alpha, int gamma> constexpr int k_comp_exp(int e)
+	template<int alpha, int gamma> constexpr int k_comp_exp(int e) noexcept
 	{
-		return (alpha - e - 1) * lg_2 + (e + 1 < alpha);
+		return floor_log10_pow2(alpha - e - 1) + (e + 1 != alpha);
 	}
 }
 
@@ -17,11 +17,14 @@
 #ifndef FLOAXIE_CROSH_H
 #define FLOAXIE_CROSH_H
 
-#include <vector>
+#include <array>
+#include <algorithm>
 #include <locale>
 #include <cstddef>
 #include <cmath>
 #include <cassert>
+#include <cfloat>
+#include <cstdint>
 
 #include <floaxie/diy_fp.h>
 #include <floaxie/static_pow.h>
@@ -30,6 +33,10 @@
 #include <floaxie/bit_ops.h>
 #include <floaxie/fraction.h>
 #include <floaxie/conversion_status.h>
+#include <floaxie/swar.h>
+#include <floaxie/digit_scan.h>
+#include <floaxie/char_class.h>
+#include <floaxie/eisel_lemire.h>
 
 namespace floaxie
 {
@@ -42,11 +49,45 @@ namespace floaxie
 	/** \brief Maximum number of decimal digits of fraction part, which can be observed. */
 	constexpr std::size_t fraction_decimal_digits(4);
 
-	/** \brief Maximum length of input string (2 KB). */
-	constexpr std::size_t maximum_offset = 2048;
+	/** \brief Absolute value of decimal exponent, which `parse_exponent()`
+	 * saturates at, as anything bigger is an overflow or underflow anyway,
+	 * unless it's compensated by mantissa of (more than) 100 million digits.
+	 */
+	constexpr int exponent_limit(100000000);
+
+	/** \brief Decimal magnitude (i.e. the number of digits before the
+	 * decimal point), starting from which values of \p **FloatType** type
+	 * aren't rounded to zero.
+	 */
+	template<typename FloatType> constexpr int min_decimal_magnitude = std::numeric_limits<FloatType>::min_exponent10 - std::numeric_limits<FloatType>::digits10 - 2;
 
-	/** \brief Maximum number of decimal digits in the exponent value. */
-	constexpr std::size_t exponent_decimal_digits(3);
+	/** \brief Maximum error (in units of the last place of `diy_fp`
+	 * mantissa) of the value **Krosh** calculates, when multiplication by
+	 * cached power of 10 is involved or mantissa is truncated.
+	 *
+	 * Both mantissa and cached power are rounded (0.5 ulp each),
+	 * multiplication adds another 0.5 ulp and normalization of the product
+	 * may double the sum.
+	 */
+	constexpr unsigned int krosh_error_margin(4);
+
+	/** \brief Returns character at the specified position of the buffer.
+	 *
+	 * Helper to read the buffer, which may be either null-terminated or
+	 * limited by the pointer to its end. The buffer is expected to be read
+	 * sequentially, so reaching the end is enough to stop.
+	 *
+	 * \param str position in the character buffer to read.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
+	 *
+	 * \return the character at \p **str** or `'\0'`, if \p **str** reached
+	 * \p **last**.
+	 */
+	template<typename CharType> constexpr CharType char_at(const CharType* str, const CharType* last) noexcept
+	{
+		return str != last ? *str : CharType();
+	}
 
 	/** \brief Tries to find and eat NaN representation in one of two forms.
 	 *
@@ -55,30 +96,38 @@ namespace floaxie
 	 * converting it to quiet NaN and finding the end of the read value.
 	 *
 	 * \param str character buffer to analyze.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
 	 *
 	 * \return number of consumed characters. Naturally, if it's equal to zero,
 	 * NaN representation wasn't found.
 	 */
-	template<typename CharType> std::size_t eat_nan(const CharType* str) noexcept
+	template<typename CharType> std::size_t eat_nan(const CharType* str, const CharType* last = nullptr) noexcept
 	{
 		std::size_t eaten(0);
 
-		if ((str[0] == 'a' || str[0] == 'A') && (str[1] == 'n' || str[1] == 'N'))
+		const CharType c0 = char_at(str, last);
+		if (c0 == 'a' || c0 == 'A')
 		{
-			const CharType* cp = str + 2;
-			eaten = 2;
-
-			/* Match `(n-char-sequence-digit)'.  */
-			if (*cp == '(')
+			const CharType c1 = char_at(str + 1, last);
+			if (c1 == 'n' || c1 == 'N')
 			{
-				do
-					++cp;
-				while ((*cp >= '0' && *cp <= '9') ||
-					   (std::tolower(*cp, std::locale()) >= 'a' && std::tolower(*cp, std::locale()) <= 'z') ||
-						*cp == '_');
+				const CharType* cp = str + 2;
+				eaten = 2;
 
-				if (*cp == ')')
-					eaten = cp - str + 1;
+				/* Match `(n-char-sequence-digit)'.  */
+				if (char_at(cp, last) == '(')
+				{
+					CharType c;
+					do
+						c = char_at(++cp, last);
+					while ((c >= '0' && c <= '9') ||
+						   (std::tolower(c, std::locale()) >= 'a' && std::tolower(c, std::locale()) <= 'z') ||
+							c == '_');
+
+					if (c == ')')
+						eaten = cp - str + 1;
+				}
 			}
 		}
 
@@ -91,34 +140,42 @@ namespace floaxie
 	 * to determine infinite floating point value representation.
 	 *
 	 * \param str character buffer to analyze.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
 	 *
 	 * \return number of consumed characters. Naturally, if it's equal to zero,
 	 * infinity representation wasn't found.
 	 */
-	template<typename CharType> std::size_t eat_inf(const CharType* str) noexcept
+	template<typename CharType> std::size_t eat_inf(const CharType* str, const CharType* last = nullptr) noexcept
 	{
 		std::size_t eaten(0);
 
-		if ((str[0] == 'n' || str[0] == 'N') && (str[1] == 'f' || str[1] == 'F'))
+		const CharType c0 = char_at(str, last);
+		if (c0 == 'n' || c0 == 'N')
 		{
-			const CharType* cp = str + 2;
-			eaten = 2;
-
-			if (*cp == 'i' || *cp == 'I')
+			const CharType c1 = char_at(str + 1, last);
+			if (c1 == 'f' || c1 == 'F')
 			{
-				++cp;
-
-				const std::array<CharType, 4> suffix {{ 'n', 'i', 't', 'y' }};
-				auto it = suffix.cbegin();
+				const CharType* cp = str + 2;
+				eaten = 2;
 
-				while (it != suffix.cend() && std::tolower(*cp, std::locale()) == *it)
+				const CharType c2 = char_at(cp, last);
+				if (c2 == 'i' || c2 == 'I')
 				{
 					++cp;
-					++it;
-				}
 
-				if (it == suffix.cend())
-					eaten = cp - str;
+					const std::array<CharType, 4> suffix {{ 'n', 'i', 't', 'y' }};
+					auto it = suffix.cbegin();
+
+					while (it != suffix.cend() && std::tolower(char_at(cp, last), std::locale()) == *it)
+					{
+						++cp;
+						++it;
+					}
+
+					if (it == suffix.cend())
+						eaten = cp - str;
+				}
 			}
 		}
 
@@ -137,12 +194,14 @@ namespace floaxie
 	 * consists of.
 	 *
 	 * \param str character buffer to extract from.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
 	 *
 	 * \return Numerator value of the extracted decimal digits (i.e. as they
 	 * are actually written after the decimal point).
 	 */
 	template<std::size_t kappa, typename CharType>
-	inline unsigned int extract_fraction_digits(const CharType* str)
+	inline unsigned int extract_fraction_digits(const CharType* str, const CharType* last = nullptr)
 	{
 		static_assert(kappa <= std::numeric_limits<int>::digits10, "Extracting values, exceeding 'int' capacity, is not supported.");
 
@@ -151,7 +210,7 @@ namespace floaxie
 
 		for (std::size_t pos = 0; pos < kappa; ++pos)
 		{
-			const auto c = str[pos] - '0';
+			const auto c = char_at(str + pos, last) - '0';
 			if (c >= 0 && c <= 9)
 				parsed_digits[pos] = c;
 			else
@@ -186,7 +245,7 @@ namespace floaxie
 	template<typename FloatType, typename CharType> struct digit_parse_result
 	{
 		/** \brief Pre-initializes members to sane values. */
-		digit_parse_result() : value(), K(0), str_end(nullptr), frac(0), special(), sign(true) { }
+		digit_parse_result() : value(), K(0), str_end(nullptr), frac(0), truncated(false), special(), sign(true) { }
 
 		/** \brief Parsed mantissa value. */
 		typename diy_fp<FloatType>::mantissa_storage_type value;
@@ -202,6 +261,12 @@ namespace floaxie
 		/** \brief Binary numerator of fractional part, to help correct rounding. */
 		unsigned char frac;
 
+		/** \brief Flag indicating, that some non-zero digits didn't fit the
+		 * mantissa, so they're taken into account only approximately (by
+		 * means of `frac`).
+		 */
+		bool truncated;
+
 		/** \brief Flag of special value possibly occured. */
 		speciality special;
 
@@ -216,6 +281,24 @@ namespace floaxie
 	 * and calculates main parts of floating point value — mantissa, exponent,
 	 * sign, fractional part.
 	 *
+	 * Mantissa digits are accumulated right into the integer value, so no
+	 * intermediate storage (and no heap allocation) is ever needed.
+	 *
+	 * Runs of up to eight digits are converted at once (see
+	 * `parse_leading_digits()`), as long as they fit the mantissa capacity.
+	 * If the end of the buffer is known, the characters are loaded by eight
+	 * at once, otherwise the digits are probed one by one up to the first
+	 * other character (see `probe_leading_digits()`), so nothing after the
+	 * terminating null character is ever read. Runs of zeros and digits
+	 * beyond the capacity are skipped by eight at once as well, so the length
+	 * of the input is not limited.
+	 *
+	 * If SIMD instructions are enabled (see `simd_digit_scan`) and the end
+	 * of the buffer is known, digits beyond the capacity are skipped by
+	 * `scan_digit_run()` instead, up to the end of the run, and the decimal
+	 * point and the exponent, which end it, are passed with no further
+	 * classification of the characters.
+	 *
 	 * \tparam kappa maximum number of digits to expect.
 	 * \tparam calc_frac if `true`, try to calculate fractional part, if any.
 	 * \tparam FloatType destination type of floating point value to store the
@@ -225,18 +308,21 @@ namespace floaxie
 	 *
 	 * \param str Character buffer with floating point value representation to
 	 * parse.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
 	 *
 	 * \return `digit_parse_result` with the parsing results.
 	 */
 	template<typename FloatType, typename CharType>
-	inline digit_parse_result<FloatType, CharType> parse_digits(const CharType* str) noexcept
+	inline digit_parse_result<FloatType, CharType> parse_digits(const CharType* str, const CharType* last = nullptr) noexcept
 	{
+		typedef typename diy_fp<FloatType>::mantissa_storage_type mantissa_storage_type;
+
 		digit_parse_result<FloatType, CharType> ret;
 
 		constexpr std::size_t kappa = decimal_q<FloatType>;
 
-		std::vector<unsigned char> parsed_digits;
-		parsed_digits.reserve(kappa);
+		std::size_t parsed_digits_count(0);
 
 		bool dot_set(false);
 		bool sign_set(false);
@@ -249,38 +335,123 @@ namespace floaxie
 
 		while(!go_to_beach)
 		{
-			const auto c = str[pos];
-			switch (c)
+			std::uint64_t chunk;
+			std::size_t known_digits(0);
+
+			// no chunk is loaded for the characters, which are not digits
+			if ((!last || str + pos < last) && static_cast<unsigned int>(str[pos] - '0') < 10)
 			{
-			case '0':
-				if (!parsed_digits.empty() || dot_set)
+				const std::size_t left(last ? static_cast<std::size_t>(last - str) - pos : 0);
+
+				if (!last)
+				{
+					known_digits = probe_leading_digits(str + pos, chunk);
+				}
+				else if (left >= swar_width && load_swar_chunk(str + pos, chunk))
+				{
+					known_digits = count_leading_digits(chunk);
+				}
+				else if (left > 1 && pos + left >= swar_width && load_swar_chunk(last - swar_width, chunk))
+				{
+					// the tail of the buffer is loaded with the characters before it
+					chunk >>= 8 * (swar_width - left);
+					known_digits = count_leading_digits(chunk);
+				}
+
+				// digits beyond the mantissa capacity only shift the exponent,
+				// once the fractional part is calculated from their head
+				if (known_digits && frac_calculated)
+				{
+					if (simd_digit_scan<CharType> && left >= digit_scan_width)
+					{
+						const auto& scan(scan_digit_run(str + pos, last));
+						std::size_t skipped(scan.digits);
+
+						pow_gain += skipped * !dot_set;
+
+						// the decimal point and the digits after it
+						if (scan.fraction && !dot_set)
+						{
+							dot_set = true;
+							skipped += scan.fraction + 1;
+						}
+
+						pos += skipped;
+
+						// the exponent ends the mantissa
+						if (scan.exponent == skipped && skipped < digit_scan_width)
+						{
+							++pos;
+							break;
+						}
+					}
+					else
+					{
+						pow_gain += known_digits * !dot_set;
+						pos += known_digits;
+					}
+
+					continue;
+				}
+
+				if (known_digits > 1)
+				{
+					// zeros, which are counted the same way as single ones
+					const std::size_t zeros(std::min(count_leading_zero_chars(chunk), known_digits));
+					if (zeros > 1 && (parsed_digits_count || dot_set))
+					{
+						zero_substring_length += zeros;
+						pow_gain += zeros * !dot_set;
+						pos += zeros;
+						continue;
+					}
+
+					// up to eight significant digits at once, with no zeros
+					// pending to be added or stripped at the end of the run
+					if (!zero_substring_length && (parsed_digits_count || swar_char(chunk, 0) != '0'))
+					{
+						std::size_t count(std::min(known_digits, kappa - parsed_digits_count));
+						while (count && swar_char(chunk, count - 1) == '0')
+							--count;
+
+						if (count > 1)
+						{
+							ret.value = ret.value * seq_pow<mantissa_storage_type, 10, kappa>(count) + parse_leading_digits(chunk, count);
+							parsed_digits_count += count;
+							fraction_digits_count += count * dot_set;
+							pos += count;
+							continue;
+						}
+					}
+				}
+			}
+
+			const auto c = char_at(str + pos, last);
+			const char_class cls(classify_char(c));
+
+			if (cls == char_class::zero)
+			{
+				if (parsed_digits_count || dot_set)
 				{
 					++zero_substring_length;
 					pow_gain += !dot_set;
 				}
-				break;
-
-			case '1':
-			case '2':
-			case '3':
-			case '4':
-			case '5':
-			case '6':
-			case '7':
-			case '8':
-			case '9':
-				if (zero_substring_length && parsed_digits.size() < kappa)
+			}
+			else if (cls == char_class::digit)
+			{
+				if (zero_substring_length && parsed_digits_count < kappa)
 				{
-					const std::size_t spare_digits { kappa - parsed_digits.size() };
+					const std::size_t spare_digits { kappa - parsed_digits_count };
 					auto zero_copy_count = zero_substring_length;
 					auto pow_gain_reduced = pow_gain;
 
-					if (!parsed_digits.empty())
+					if (parsed_digits_count)
 					{
 						zero_copy_count = std::min(zero_substring_length, spare_digits);
 						pow_gain_reduced = std::min(pow_gain, spare_digits);
 
-						parsed_digits.insert(parsed_digits.end(), zero_copy_count, 0);
+						ret.value *= seq_pow<mantissa_storage_type, 10, kappa>(zero_copy_count);
+						parsed_digits_count += zero_copy_count;
 					}
 
 					fraction_digits_count += zero_copy_count - pow_gain_reduced;
@@ -288,50 +459,51 @@ namespace floaxie
 					pow_gain -= pow_gain_reduced;
 				}
 
-				if (parsed_digits.size() < kappa)
+				if (parsed_digits_count < kappa)
 				{
-					parsed_digits.push_back(c - '0');
+					ret.value = ret.value * 10 + static_cast<mantissa_storage_type>(c - '0');
+					++parsed_digits_count;
 					fraction_digits_count += dot_set;
 				}
 				else
 				{
 					if (!frac_calculated)
 					{
-						const std::size_t frac_suffix_size = parsed_digits.size() + zero_substring_length - kappa;
-						auto tail = extract_fraction_digits<fraction_decimal_digits>(str + pos - frac_suffix_size);
+						const std::size_t frac_suffix_size = parsed_digits_count + zero_substring_length - kappa;
+						auto tail = extract_fraction_digits<fraction_decimal_digits>(str + pos - frac_suffix_size, last);
 						ret.frac = convert_numerator<fraction_decimal_digits, fraction_binary_digits>(tail);
 
 						frac_calculated = true;
+						ret.truncated = true;
 					}
 
 					pow_gain += !dot_set;
 				}
-				break;
-
-			case '.':
+			}
+			else if (cls == char_class::dot)
+			{
 				go_to_beach = dot_set;
 				dot_set = true;
-				break;
-
-			case 'n':
-			case 'N':
-				if (pos == sign_set)
+			}
+			else if (cls == char_class::sign && pos == 0)
+			{
+				ret.sign = static_cast<bool>('-' - c); // '+' => true, '-' => false
+				sign_set = true;
+			}
+			else
+			{
+				// special values are recognized only at the beginning
+				if (pos == sign_set && cls == char_class::nan)
 				{
-					const std::size_t eaten = eat_nan(str + pos + 1);
+					const std::size_t eaten = eat_nan(str + pos + 1, last);
 					pos += eaten + 1;
 
 					if (eaten)
 						ret.special = speciality::nan;
 				}
-
-				go_to_beach = true;
-				break;
-
-			case 'i':
-			case 'I':
-				if (pos == sign_set)
+				else if (pos == sign_set && cls == char_class::inf)
 				{
-					const std::size_t eaten = eat_inf(str + pos + 1);
+					const std::size_t eaten = eat_inf(str + pos + 1, last);
 					pos += eaten + 1;
 
 					if (eaten)
@@ -339,32 +511,11 @@ namespace floaxie
 				}
 
 				go_to_beach = true;
-				break;
-
-			case '-':
-			case '+':
-				if (pos == 0)
-				{
-					ret.sign = static_cast<bool>('-' - c); // '+' => true, '-' => false
-					sign_set = true;
-					break;
-				}
-				// fall through
-
-			default:
-				go_to_beach = true;
-				break;
 			}
 
-			go_to_beach |= pos > maximum_offset;
-
 			++pos;
 		}
 
-		std::size_t pow(0);
-		for (auto rit = parsed_digits.rbegin(); rit != parsed_digits.rend(); ++rit)
-			ret.value += (*rit) * seq_pow<typename diy_fp<FloatType>::mantissa_storage_type, 10, decimal_q<FloatType>>(pow++);
-
 		ret.str_end = str + (pos - 1);
 		ret.K = pow_gain - fraction_digits_count;
 
@@ -387,6 +538,15 @@ namespace floaxie
 		/** \brief Pointer to the memory after the parsed part of the buffer. */
 		const CharType* str_end;
 
+		/** \brief Decimal mantissa value as parsed (i.e. without fractional
+		 * part), so that the value is `digits` * 10 ^ `K`, unless
+		 * `truncated` is set.
+		 */
+		typename diy_fp<FloatType>::mantissa_storage_type digits;
+
+		/** \brief Flag indicating, that the mantissa value is approximate. */
+		bool truncated;
+
 		/** \brief Flag of special value. */
 		speciality special;
 
@@ -404,20 +564,19 @@ namespace floaxie
 	 * \tparam CharType character type (typically `char` or `wchar_t`) \p **str**
 	 * consists of.
 	 *
-	 * \param str Character buffer with floating point value representation to
-	 * parse.
+	 * \param digits_parts results of `parse_digits()`.
 	 *
 	 * \return `mantissa_parse_result` structure with the results of parsing
 	 * and corrections.
 	 */
-	template<typename FloatType, typename CharType> inline mantissa_parse_result<FloatType, CharType> parse_mantissa(const CharType* str)
+	template<typename FloatType, typename CharType> inline mantissa_parse_result<FloatType, CharType> parse_mantissa(const digit_parse_result<FloatType, CharType>& digits_parts)
 	{
 		mantissa_parse_result<FloatType, CharType> ret;
 
-		const auto& digits_parts(parse_digits<FloatType>(str));
-
 		ret.special = digits_parts.special;
 		ret.str_end = digits_parts.str_end;
+		ret.digits = digits_parts.value;
+		ret.truncated = digits_parts.truncated;
 		ret.sign = digits_parts.sign;
 
 		if (digits_parts.special == speciality::no)
@@ -453,6 +612,28 @@ namespace floaxie
 		return ret;
 	}
 
+	/** \brief Parses mantissa part of floating point value representation.
+	 *
+	 * Shorthand for `parse_digits()` and `parse_mantissa()` of its results.
+	 *
+	 * \tparam FloatType destination type of floating point value to store the
+	 * results.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) \p **str**
+	 * consists of.
+	 *
+	 * \param str Character buffer with floating point value representation to
+	 * parse.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
+	 *
+	 * \return `mantissa_parse_result` structure with the results of parsing
+	 * and corrections.
+	 */
+	template<typename FloatType, typename CharType> inline mantissa_parse_result<FloatType, CharType> parse_mantissa(const CharType* str, const CharType* last = nullptr)
+	{
+		return parse_mantissa(parse_digits<FloatType>(str, last));
+	}
+
 	/** \brief Return structure for `parse_exponent`.
 	 *
 	 * \tparam CharType character type (typically `char` or `wchar_t`) used.
@@ -467,37 +648,124 @@ namespace floaxie
 	};
 
 	/** \brief Parses exponent part of the floating point string representation.
+	 *
+	 * Reads 'e' (or 'E') character, optional sign and decimal digits of the
+	 * exponent, saturating its value at `exponent_limit` (leading zeros and
+	 * any number of digits are accepted). If there are no digits after 'e'
+	 * and the sign, there's no exponent part at all and nothing is consumed,
+	 * just like `strtod()` does.
 	 *
 	 * \tparam CharType character type (typically `char` or `wchar_t`) of \p **str**.
 	 *
 	 * \param str Exponent part of character buffer with floating point value
 	 * representation to parse.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
 	 *
 	 * \return `exponent_parse_result` structure with parse results.
 	 */
-	template<typename CharType> inline exponent_parse_result<CharType> parse_exponent(const CharType* str)
+	template<typename CharType> inline exponent_parse_result<CharType> parse_exponent(const CharType* str, const CharType* last = nullptr) noexcept
 	{
-		exponent_parse_result<CharType> ret;
-		if (*str != 'e' && *str != 'E')
+		exponent_parse_result<CharType> ret { 0, str };
+
+		const CharType c(char_at(str, last));
+		if (c != 'e' && c != 'E')
+			return ret;
+
+		const CharType* p(str + 1);
+
+		const CharType sign(char_at(p, last));
+		const bool negative(sign == '-');
+		p += negative || sign == '+';
+
+		unsigned int digit(static_cast<unsigned int>(char_at(p, last) - '0'));
+		if (digit > 9)
+			return ret;
+
+		int value(0);
+
+		do
 		{
-			ret.value = 0;
-			ret.str_end = str;
+			value = std::min(value * 10 + int(digit), exponent_limit);
+
+			digit = static_cast<unsigned int>(char_at(++p, last) - '0');
 		}
-		else
+		while (digit <= 9);
+
+		ret.value = negative ? -value : value;
+		ret.str_end = p;
+
+		return ret;
+	}
+
+	/** \brief Template structure to define parameters of exact fast path
+	 * (by William D. Clinger) for selected floating point types.
+	 *
+	 * If both decimal mantissa and power of 10 are exactly representable in
+	 * the floating point type, the result of one floating point
+	 * multiplication (or division) of them is rounded correctly.
+	 */
+	template<typename FloatType> struct fast_path_traits;
+
+	/** \brief `fast_path_traits` specialization for `float`. */
+	template<> struct fast_path_traits<float>
+	{
+		/** \brief Maximum mantissa value, which is exact. */
+		static constexpr std::uint64_t max_mantissa = std::uint64_t(1) << 24;
+
+		/** \brief Maximum absolute value of exponent, for which power of 10
+		 * is exact.
+		 */
+		static constexpr int max_power = 10;
+
+		/** \brief Exact powers of 10. */
+		static constexpr float powers[] =
 		{
-			++str;
+			1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+		};
+	};
 
-			const auto& digit_parts(parse_digits<float>(str));
+	/** \brief `fast_path_traits` specialization for `double`. */
+	template<> struct fast_path_traits<double>
+	{
+		/** \brief Maximum mantissa value, which is exact. */
+		static constexpr std::uint64_t max_mantissa = std::uint64_t(1) << 53;
 
-			ret.value = digit_parts.value * seq_pow<int, 10, exponent_decimal_digits>(digit_parts.K);
+		/** \brief Maximum absolute value of exponent, for which power of 10
+		 * is exact.
+		 */
+		static constexpr int max_power = 22;
 
-			if (!digit_parts.sign)
-				ret.value = -ret.value;
+		/** \brief Exact powers of 10. */
+		static constexpr double powers[] =
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+	};
 
-			ret.str_end = digit_parts.str_end;
-		}
+	constexpr float fast_path_traits<float>::powers[];
+	constexpr double fast_path_traits<double>::powers[];
 
-		return ret;
+	/** \brief Checks if exact fast path can be used for the value.
+	 *
+	 * The path is disabled, if floating point operations are evaluated in
+	 * wider precision (e.g. by x87 FPU), as double rounding may occur then.
+	 *
+	 * \param mantissa decimal mantissa value.
+	 * \param K decimal exponent value.
+	 *
+	 * \return `true`, if both mantissa and power of 10 are exact in
+	 * \p **FloatType**.
+	 */
+	template<typename FloatType> constexpr bool fast_path_applicable(std::uint64_t mantissa, int K) noexcept
+	{
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+		return (void)mantissa, (void)K, false;
+#else
+		return mantissa <= fast_path_traits<FloatType>::max_mantissa &&
+			K >= -fast_path_traits<FloatType>::max_power && K <= fast_path_traits<FloatType>::max_power;
+#endif
 	}
 
 	/** \brief Return structure, containing **Krosh** algorithm results.
@@ -524,6 +792,12 @@ namespace floaxie
 	};
 
 	/** \brief Implements **Krosh** algorithm.
+	 *
+	 * If the result of multiplication by 64-bit cached power is too close to
+	 * the middle between two floating point values to be rounded correctly,
+	 * the calculation is repeated with 128-bit power (see `eisel_lemire()`).
+	 * Only the cases, where even this is not enough, are reported
+	 * inaccurate.
 	 *
 	 * \tparam FloatType destination type of floating point value to store the
 	 * results.
@@ -533,65 +807,91 @@ namespace floaxie
 	 *
 	 * \param str Character buffer with floating point value
 	 * representation to parse.
+	 * \param last pointer to the end of the buffer or `nullptr`, if the
+	 * buffer is null-terminated.
 	 *
 	 * \return `krosh_result` structure with all the results of **Krosh**
 	 * algorithm.
 	 */
-	template<typename FloatType, typename CharType> krosh_result<FloatType, CharType> krosh(const CharType* str)
+	template<typename FloatType, typename CharType> krosh_result<FloatType, CharType> krosh(const CharType* str, const CharType* last = nullptr)
 	{
 		krosh_result<FloatType, CharType> ret;
 
 		static_assert(sizeof(FloatType) <= sizeof(typename diy_fp<FloatType>::mantissa_storage_type), "Only floating point types no longer, than 64 bits are supported.");
 
-		auto mp(parse_mantissa<FloatType>(str));
+		const auto& dp(parse_digits<FloatType>(str, last));
 
-		if (mp.special == speciality::no && mp.value.mantissa())
+		if (dp.special == speciality::no && dp.value)
 		{
-			diy_fp<FloatType>& w(mp.value);
-
-			const auto& ep(parse_exponent(mp.str_end));
+			const auto& ep(parse_exponent(dp.str_end, last));
 
-			mp.K += ep.value;
+			const int K(dp.K + ep.value);
+			ret.str_end = ep.str_end;
 
-			if (mp.K)
+			if (!dp.truncated && fast_path_applicable<FloatType>(dp.value, K))
 			{
+				// both mantissa and power of 10 are exact, so is the result
+				ret.value = K < 0 ?
+					FloatType(dp.value) / fast_path_traits<FloatType>::powers[-K] :
+					FloatType(dp.value) * fast_path_traits<FloatType>::powers[K];
+				ret.is_accurate = true;
+				ret.status = conversion_status::success;
+			}
+			else
+			{
+				auto mp(parse_mantissa(dp));
+				mp.K = K;
+
+				diy_fp<FloatType>& w(mp.value);
+
 				const bool b1 = mp.K >= powers_ten<FloatType>::boundaries.first;
 				const bool b2 = mp.K <= powers_ten<FloatType>::boundaries.second;
 
 				if (b1 && b2)
 				{
-					w *= cached_power<FloatType>(mp.K);
+					if (mp.K)
+						w *= cached_power<FloatType>(mp.K);
+
+					w.normalize();
+					const auto& v(w.downsample(mp.K || mp.truncated ? krosh_error_margin : 0));
+					ret.value = v.value;
+					ret.is_accurate = v.is_accurate;
+					ret.status = v.status;
 				}
-				else
+				else if (!b1)
 				{
-					if (!b1)
-					{
-						ret.value = FloatType(0);
-						ret.status = conversion_status::underflow;
-					}
-					else // !b2
-					{
-						ret.value = huge_value<FloatType>();
-						ret.status = conversion_status::overflow;
-					}
+					ret.value = FloatType(0);
+					ret.status = conversion_status::underflow;
 
-					ret.str_end = ep.str_end;
+					// mantissa is less, than 10 ^ (decimal_q + 1), so
+					// the value may still be big enough for denormals
+					ret.is_accurate = mp.K + int(decimal_q<FloatType>) + 1 < min_decimal_magnitude<FloatType>;
+				}
+				else // !b2
+				{
+					ret.value = huge_value<FloatType>();
+					ret.status = conversion_status::overflow;
 					ret.is_accurate = true;
+				}
+
+				// try more precise calculation before giving up
+				if (!ret.is_accurate)
+				{
+					const auto& el(eisel_lemire<FloatType>(mp.digits, mp.K));
 
-					return ret;
+					// truncated digits value is somewhere between the two
+					if (el.is_accurate && (!mp.truncated || eisel_lemire<FloatType>(mp.digits + 1, mp.K).value == el.value))
+					{
+						ret.value = el.value;
+						ret.is_accurate = true;
+						ret.status = el.status;
+					}
 				}
 			}
-
-			w.normalize();
-			const auto& v(w.downsample());
-			ret.value = v.value;
-			ret.str_end = ep.str_end;
-			ret.is_accurate = v.is_accurate;
-			ret.status = v.status;
 		}
 		else
 		{
-			switch (mp.special)
+			switch (dp.special)
 			{
 			case speciality::nan:
 				ret.value = std::numeric_limits<FloatType>::quiet_NaN();
@@ -606,12 +906,14 @@ namespace floaxie
 				break;
 			}
 
-			ret.str_end = mp.str_end;
+			// exponent of zero value is still a part of its representation
+			const bool has_digits(dp.special == speciality::no && std::any_of(str, dp.str_end, [](CharType c) { return c >= '0' && c <= '9'; }));
+			ret.str_end = has_digits ? parse_exponent(dp.str_end, last).str_end : dp.str_end;
 			ret.is_accurate = true;
 			ret.status = conversion_status::success;
 		}
 
-		if (!mp.sign)
+		if (!dp.sign)
 			ret.value = -ret.value;
 
 		return ret;
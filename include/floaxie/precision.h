@@ -0,0 +1,597 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * grisu_precision() and round_weed_counted() functions are based on
+ * precision mode of Grisu algorithm from double-conversion library
+ * (https://github.com/google/double-conversion)
+ */
+
+#ifndef FLOAXIE_PRECISION_H
+#define FLOAXIE_PRECISION_H
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstddef>
+#include <cassert>
+
+#include <floaxie/diy_fp.h>
+#include <floaxie/cached_power.h>
+#include <floaxie/k_comp.h>
+#include <floaxie/grisu.h>
+#include <floaxie/big_int.h>
+#include <floaxie/bit_ops.h>
+#include <floaxie/prettify.h>
+#include <floaxie/chars_format.h>
+
+namespace floaxie
+{
+	/** \brief Maximum number of significant digits in exact decimal
+	 * representation of `double` value (all the further digits are zeros).
+	 */
+	constexpr std::size_t max_exact_digits(767);
+
+	/** \brief Default precision, used when negative one is specified (just
+	 * like `printf()` does).
+	 */
+	constexpr int default_precision(6);
+
+	/** \brief Kind of precision the digits are generated with. */
+	enum class precision_type : unsigned char
+	{
+		significant, /**< Number of significant digits. */
+		fractional /**< Number of digits after decimal point. */
+	};
+
+	/** \brief Digits of a value, rounded to the specified precision.
+	 *
+	 * As the number of digits is not limited, only the first `length` ones
+	 * are stored, and the rest `count` - `length` digits are zeros.
+	 */
+	struct precision_digits
+	{
+		/** \brief Stored digit characters. */
+		char digits[max_exact_digits + 1];
+		/** \brief Number of stored digits. */
+		int length;
+		/** \brief Number of all the digits (including zeros not stored). */
+		int count;
+		/** \brief Decimal exponent of the last digit. */
+		int K;
+	};
+
+	/** \brief Rounds the digits up by one unit of the last digit.
+	 *
+	 * If all the digits are nines, they are replaced by one and zeros, which
+	 * increments decimal exponent for `precision_type::significant` (the
+	 * number of digits is kept the same) or the number of digits for
+	 * `precision_type::fractional` (the position of the last digit is kept).
+	 */
+	inline void round_up(precision_digits& pd, precision_type type) noexcept
+	{
+		int i(pd.length);
+
+		while (i > 0 && pd.digits[i - 1] == '9')
+			--i;
+
+		if (i > 0)
+		{
+			++pd.digits[i - 1];
+			pd.length = i;
+		}
+		else
+		{
+			pd.digits[0] = '1';
+			pd.length = 1;
+
+			if (type == precision_type::significant)
+				++pd.K;
+			else
+				++pd.count;
+		}
+	}
+
+	/** \brief Rounds the generated digits, if it's ensured to be correct
+	 * in spite of the error of the scaled value.
+	 *
+	 * \param pd the generated digits.
+	 * \param type precision type the digits are generated with.
+	 * \param rest the rest of the scaled value after the last digit.
+	 * \param ten_kappa scaled weight of the last digit.
+	 * \param unit maximum error of the scaled value.
+	 *
+	 * \return `true`, if the rounding is ensured to be correct.
+	 */
+	template<typename MantissaType>
+	inline bool round_weed_counted(precision_digits& pd, precision_type type, MantissaType rest, MantissaType ten_kappa, MantissaType unit) noexcept
+	{
+		assert(rest < ten_kappa);
+
+		// the error is too big to know, which way to round
+		if (unit >= ten_kappa || ten_kappa - unit <= unit)
+			return false;
+
+		// 2 * (rest + unit) <= 10^kappa, so rounding down is safe
+		if (ten_kappa - rest > rest && ten_kappa - 2 * rest >= 2 * unit)
+			return true;
+
+		// 2 * (rest - unit) >= 10^kappa, so rounding up is safe
+		if (rest > unit && ten_kappa - (rest - unit) <= rest - unit)
+		{
+			round_up(pd, type);
+			return true;
+		}
+
+		return false;
+	}
+
+	/** \brief **Grisu** algorithm in precision mode.
+	 *
+	 * Generates the digits of the value scaled by cached power of 10 until
+	 * the requested precision is reached, and rounds them, if the error of
+	 * the scaled value can't affect the rounding. Otherwise (including the
+	 * halfway cases, which always need exact rounding to even, and the cases
+	 * of more digits, than the scaled value has) it reports the failure, so
+	 * that the digits are regenerated by `exact_precision()`.
+	 *
+	 * \tparam alpha α value of **Grisu** algorithm.
+	 * \tparam gamma γ value of **Grisu** algorithm.
+	 *
+	 * \param v positive floating point value to print.
+	 * \param precision number of digits to generate.
+	 * \param type meaning of \p **precision** value.
+	 * \param pd structure to store the digits to.
+	 *
+	 * \return `true`, if the digits are ensured to be correctly rounded.
+	 */
+	template<int alpha, int gamma>
+	inline bool grisu_precision(double v, int precision, precision_type type, precision_digits& pd) noexcept
+	{
+		typedef diy_fp<double>::mantissa_storage_type mantissa_storage_type;
+
+		diy_fp<double> w(v);
+		w.normalize();
+
+		const int mk(k_comp_exp<alpha, gamma>(w.exponent()));
+		w *= cached_power<double>(mk);
+
+		const diy_fp<double> one(raised_bit<mantissa_storage_type>(-w.exponent()), w.exponent());
+
+		half_of_mantissa_storage_type p1 = w.mantissa() >> -one.exponent();
+		mantissa_storage_type p2 = w.mantissa() & (one.mantissa() - 1);
+
+		const kappa_pair_type kappa_div(calculate_kappa_div(p1));
+		int kappa(kappa_div.first);
+		half_of_mantissa_storage_type div(kappa_div.second);
+
+		int count(type == precision_type::significant ? precision : kappa - mk + precision);
+
+		pd.length = 0;
+		pd.count = std::max(count, 0);
+		pd.K = kappa - mk - count;
+
+		// the value is less, than one tenth of the last digit unit, so it's
+		// rounded to zero, but in case of exactly one digit rounding is left
+		// to the exact algorithm, as the value may be close to the half
+		if (count <= 0)
+			return count < 0;
+
+		mantissa_storage_type unit(1);
+
+		while (kappa > 0)
+		{
+			pd.digits[pd.length++] = '0' + p1 / div;
+			p1 %= div;
+			--kappa;
+
+			if (--count == 0)
+			{
+				const mantissa_storage_type rest((mantissa_storage_type(p1) << -one.exponent()) + p2);
+				return round_weed_counted(pd, type, rest, mantissa_storage_type(div) << -one.exponent(), unit);
+			}
+
+			div /= 10;
+		}
+
+		while (p2 > unit)
+		{
+			p2 *= 10;
+			unit *= 10;
+
+			pd.digits[pd.length++] = '0' + static_cast<char>(p2 >> -one.exponent());
+			p2 &= one.mantissa() - 1;
+
+			if (--count == 0)
+				return round_weed_counted(pd, type, p2, one.mantissa(), unit);
+		}
+
+		return false;
+	}
+
+	/** \brief Generates the digits of the value, rounded to the precision,
+	 * by exact calculations.
+	 *
+	 * The value is scaled to the ratio of integers of `big_int` type, so the
+	 * digits are always exact and halfway cases are rounded to even digit.
+	 * It is much slower, than **Grisu**, so it's only used, when
+	 * `grisu_precision()` fails.
+	 *
+	 * \param v positive floating point value to print.
+	 * \param precision number of digits to generate.
+	 * \param type meaning of \p **precision** value.
+	 * \param pd structure to store the digits to.
+	 */
+	inline void exact_precision(double v, int precision, precision_type type, precision_digits& pd) noexcept
+	{
+		typedef diy_fp<double>::mantissa_storage_type mantissa_storage_type;
+
+		const diy_fp<double> w(v);
+
+		assert(w.mantissa());
+
+		// v = r / s
+		big_int r(w.mantissa()), s(1);
+
+		r.shift_left(std::max(w.exponent(), 0));
+		s.shift_left(std::max(-w.exponent(), 0));
+
+		// 10 ^ (k - 1) <= v < 10 ^ (k + 1)
+		int k(floor_log10_pow2(w.exponent() + int(bit_size<mantissa_storage_type>()) - count_leading_zeros(w.mantissa()) - 1) + 1);
+
+		if (k >= 0)
+			s.multiply_pow10(k);
+		else
+			r.multiply_pow10(-k);
+
+		if (compare(r, s) >= 0)
+		{
+			s.multiply_add(10, 0);
+			++k;
+		}
+
+		const int count(type == precision_type::significant ? precision : k + precision);
+
+		pd.length = 0;
+		pd.count = std::max(count, 0);
+		pd.K = k - count;
+
+		// the value is less, than one tenth of the last digit unit
+		if (count < 0)
+			return;
+
+		while (pd.length < count && !r.is_zero())
+		{
+			r.multiply_add(10, 0);
+
+			char d('0');
+			while (compare(r, s) >= 0)
+			{
+				r.subtract(s);
+				++d;
+			}
+
+			assert(pd.length < int(max_exact_digits));
+			pd.digits[pd.length++] = d;
+		}
+
+		if (pd.length == count && !r.is_zero())
+		{
+			r.shift_left(1);
+
+			const int cmp(compare(r, s));
+			if (cmp > 0 || (cmp == 0 && count > 0 && (pd.digits[count - 1] & 1)))
+				round_up(pd, type);
+		}
+	}
+
+	/** \brief Generates the digits of the value, rounded to the precision.
+	 *
+	 * `float` values are printed as `double` ones, just like `printf()`
+	 * does, as the conversion is exact.
+	 *
+	 * \tparam FloatType type of input floating-point value (calculated by type
+	 * of \p **v** parameter).
+	 *
+	 * \param v positive floating point value to print.
+	 * \param precision number of digits to generate.
+	 * \param type meaning of \p **precision** value.
+	 * \param pd structure to store the digits to.
+	 */
+	template<typename FloatType> inline void generate_precision_digits(FloatType v, int precision, precision_type type, precision_digits& pd) noexcept
+	{
+		constexpr int alpha(grisu_parameters<double>.alpha), gamma(grisu_parameters<double>.gamma);
+
+		const double d(v);
+
+		if (!grisu_precision<alpha, gamma>(d, precision, type, pd))
+			exact_precision(d, precision, type, pd);
+	}
+
+	/** \brief Prints the digits in the specified range of their indices,
+	 * substituting zeros for the ones, which are not stored.
+	 *
+	 * \return pointer to the character after the last printed one.
+	 */
+	template<typename CharType> inline CharType* put_precision_digits(const precision_digits& pd, int first, int last, CharType* buffer) noexcept
+	{
+		for (; first < last && first < 0; ++first)
+			*buffer++ = '0';
+
+		for (; first < last && first < pd.length; ++first)
+			*buffer++ = pd.digits[first];
+
+		for (; first < last; ++first)
+			*buffer++ = '0';
+
+		return buffer;
+	}
+
+	/** \brief Calculates the length of the digits in decimal format. */
+	inline std::size_t fixed_length(const precision_digits& pd) noexcept
+	{
+		const int dot_pos(pd.K + pd.count);
+		const int fraction(std::max(-pd.K, 0));
+
+		return std::max(dot_pos, 1) + (fraction ? fraction + 1 : 0);
+	}
+
+	/** \brief Prints the digits in decimal format.
+	 *
+	 * \return number of characters written to the buffer.
+	 */
+	template<typename CharType> inline std::size_t print_fixed(const precision_digits& pd, CharType* buffer) noexcept
+	{
+		const int dot_pos(pd.K + pd.count);
+		const int fraction(std::max(-pd.K, 0));
+
+		CharType* p(buffer);
+
+		if (dot_pos > 0)
+			p = put_precision_digits(pd, 0, dot_pos, p);
+		else
+			*p++ = '0';
+
+		if (fraction)
+		{
+			*p++ = '.';
+			p = put_precision_digits(pd, dot_pos, dot_pos + fraction, p);
+		}
+
+		return p - buffer;
+	}
+
+	/** \brief Calculates the length of the digits in decimal exponent
+	 * format.
+	 */
+	inline std::size_t exponential_length(const precision_digits& pd) noexcept
+	{
+		const int K(pd.K + pd.count - 1);
+
+		return 1 + (pd.count > 1 ? pd.count : 0) + 2 + (K >= 100 || K <= -100 ? 3 : 2);
+	}
+
+	/** \brief Prints the digits in decimal exponent format with sign and at
+	 * least two digits of the exponent, just like `printf()` does.
+	 *
+	 * \return number of characters written to the buffer.
+	 */
+	template<typename CharType> inline std::size_t print_exponential(const precision_digits& pd, CharType* buffer) noexcept
+	{
+		const int K(pd.K + pd.count - 1);
+
+		CharType* p(put_precision_digits(pd, 0, 1, buffer));
+
+		if (pd.count > 1)
+		{
+			*p++ = '.';
+			p = put_precision_digits(pd, 1, pd.count, p);
+		}
+
+		*p++ = 'e';
+		*p++ = K < 0 ? '-' : '+';
+		p += fill_exponent(K < 0 ? -K : K, p);
+
+		return p - buffer;
+	}
+
+	/** \brief Generates the digits of the value in the format of `printf()`
+	 * conversion with the specified precision.
+	 *
+	 * `chars_format::fixed` corresponds to `%.*f`, `chars_format::scientific`
+	 * to `%.*e` and `chars_format::general` to `%.*g` (hexadecimal format is
+	 * not supported and is treated as general one).
+	 *
+	 * \tparam FloatType type of input floating-point value (calculated by type
+	 * of \p **v** parameter).
+	 *
+	 * \param v positive or zero floating point value to print.
+	 * \param fmt `printf()` conversion to follow.
+	 * \param precision precision of the conversion (negative value means
+	 * `default_precision`).
+	 * \param pd structure to store the digits to.
+	 *
+	 * \return format the digits should be printed in.
+	 */
+	template<typename FloatType> inline format prepare_precision(FloatType v, chars_format fmt, int precision, precision_digits& pd) noexcept
+	{
+		if (precision < 0)
+			precision = default_precision;
+
+		switch (fmt)
+		{
+		case chars_format::fixed:
+			if (v != 0)
+			{
+				generate_precision_digits(v, precision, precision_type::fractional, pd);
+			}
+			else
+			{
+				pd.length = 0;
+				pd.count = precision + 1;
+				pd.K = -precision;
+			}
+
+			return format::decimal;
+
+		case chars_format::scientific:
+			if (v != 0)
+			{
+				generate_precision_digits(v, precision + 1, precision_type::significant, pd);
+			}
+			else
+			{
+				pd.length = 0;
+				pd.count = precision + 1;
+				pd.K = -precision;
+			}
+
+			return format::scientific;
+
+		default:
+			break;
+		}
+
+		precision += !precision;
+
+		if (v == 0)
+		{
+			pd.length = 0;
+			pd.count = 1;
+			pd.K = 0;
+
+			return format::decimal;
+		}
+
+		generate_precision_digits(v, precision, precision_type::significant, pd);
+
+		const int K(pd.K + pd.count - 1);
+
+		// trailing zeros are not printed
+		while (pd.digits[pd.length - 1] == '0')
+			--pd.length;
+
+		pd.count = pd.length;
+		pd.K = K - pd.count + 1;
+
+		return precision > K && K >= -4 ? format::decimal : format::scientific;
+	}
+
+	/** \brief Calculates the length of the digits in the specified format. */
+	inline std::size_t precision_length(const precision_digits& pd, format f) noexcept
+	{
+		return f == format::decimal ? fixed_length(pd) : exponential_length(pd);
+	}
+
+	/** \brief Prints the digits in the specified format.
+	 *
+	 * \return number of characters written to the buffer.
+	 */
+	template<typename CharType> inline std::size_t print_precision(const precision_digits& pd, format f, CharType* buffer) noexcept
+	{
+		return f == format::decimal ? print_fixed(pd, buffer) : print_exponential(pd, buffer);
+	}
+
+	/** \brief Returns buffer size, which is enough to print any value of
+	 * the specified type by `ftoa_precision()` with the specified
+	 * precision.
+	 */
+	template<typename FloatType> constexpr std::size_t max_precision_buffer_size(int precision) noexcept
+	{
+		// sign, integral digits, '.', fractional digits and '\0'
+		return 1 + std::numeric_limits<FloatType>::max_exponent10 + 1 + 1 + std::size_t(precision < 0 ? default_precision : precision) + 1;
+	}
+
+	/** \brief Prints special (NaN or infinite) floating point value the way
+	 * `printf()` does.
+	 *
+	 * \return number of characters written (no terminating null character is
+	 * written).
+	 */
+	template<typename FloatType, typename CharType> inline std::size_t print_special_precision(FloatType v, CharType* buffer) noexcept
+	{
+		*buffer = '-';
+		buffer += std::signbit(v);
+
+		if (std::isnan(v))
+		{
+			buffer[0] = 'n';
+			buffer[1] = 'a';
+			buffer[2] = 'n';
+		}
+		else
+		{
+			buffer[0] = 'i';
+			buffer[1] = 'n';
+			buffer[2] = 'f';
+		}
+
+		return std::signbit(v) + 3;
+	}
+
+	/** \brief Prints floating point value with the specified precision the
+	 * same way `printf()` does.
+	 *
+	 * Unlike `ftoa()`, which prints the shortest representation, prints the
+	 * value correctly rounded (halfway cases are rounded to even digit) to
+	 * the specified number of digits, matching `printf()` of GNU C library
+	 * byte for byte (in "C" locale and with default rounding mode). The
+	 * digits are generated by **Grisu** algorithm in precision mode, and
+	 * only those cases, when its result is not ensured to be correct, are
+	 * regenerated by slower, but exact algorithm of big integers.
+	 *
+	 * \tparam FloatType type of floating point value, calculated using passed
+	 * input parameter \p **v**.
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer \p **buffer**.
+	 *
+	 * \param v floating point value to print.
+	 * \param buffer character buffer of enough size (see
+	 * `max_precision_buffer_size()`) to print the representation to.
+	 * \param fmt `printf()` conversion to follow: `chars_format::fixed` for
+	 * `%.*f`, `chars_format::scientific` for `%.*e` and
+	 * `chars_format::general` for `%.*g`.
+	 * \param precision precision of the conversion (negative value means
+	 * `default_precision`, just like in `printf()`).
+	 *
+	 * \return number of characters actually written.
+	 *
+	 * \see `max_precision_buffer_size()`
+	 */
+	template<typename FloatType, typename CharType>
+	inline std::size_t ftoa_precision(FloatType v, CharType* buffer, chars_format fmt, int precision) noexcept
+	{
+		std::size_t length;
+
+		if (std::isfinite(v))
+		{
+			*buffer = '-';
+			const bool negative(std::signbit(v));
+
+			precision_digits pd;
+			const format f(prepare_precision(std::fabs(v), fmt, precision, pd));
+			length = negative + print_precision(pd, f, buffer + negative);
+		}
+		else
+		{
+			length = print_special_precision(v, buffer);
+		}
+
+		buffer[length] = '\0';
+
+		return length;
+	}
+}
+
+#endif // FLOAXIE_PRECISION_H
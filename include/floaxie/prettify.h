@@ -28,8 +28,11 @@
 #include <cassert>
 #include <cstdlib>
 #include <algorithm>
+#include <limits>
+#include <cstdint>
 
 #include <floaxie/static_pow.h>
+#include <floaxie/digits_lut.h>
 #include <floaxie/print.h>
 #include <floaxie/memwrap.h>
 
@@ -45,20 +48,6 @@ namespace floaxie
 		scientific
 	};
 
-	/** \brief LUT of two-digit decimal values to speed up their printing. */
-	constexpr const char digits_lut[200] = {
-		'0', '0', '0', '1', '0', '2', '0', '3', '0', '4', '0', '5', '0', '6', '0', '7', '0', '8', '0', '9',
-		'1', '0', '1', '1', '1', '2', '1', '3', '1', '4', '1', '5', '1', '6', '1', '7', '1', '8', '1', '9',
-		'2', '0', '2', '1', '2', '2', '2', '3', '2', '4', '2', '5', '2', '6', '2', '7', '2', '8', '2', '9',
-		'3', '0', '3', '1', '3', '2', '3', '3', '3', '4', '3', '5', '3', '6', '3', '7', '3', '8', '3', '9',
-		'4', '0', '4', '1', '4', '2', '4', '3', '4', '4', '4', '5', '4', '6', '4', '7', '4', '8', '4', '9',
-		'5', '0', '5', '1', '5', '2', '5', '3', '5', '4', '5', '5', '5', '6', '5', '7', '5', '8', '5', '9',
-		'6', '0', '6', '1', '6', '2', '6', '3', '6', '4', '6', '5', '6', '6', '6', '7', '6', '8', '6', '9',
-		'7', '0', '7', '1', '7', '2', '7', '3', '7', '4', '7', '5', '7', '6', '7', '7', '7', '8', '7', '9',
-		'8', '0', '8', '1', '8', '2', '8', '3', '8', '4', '8', '5', '8', '6', '8', '7', '8', '8', '8', '9',
-		'9', '0', '9', '1', '9', '2', '9', '3', '9', '4', '9', '5', '9', '6', '9', '7', '9', '8', '9', '9'
-	};
-
 	/** \brief Detects the more appropriate format to print based on
 	 * \p **threshold** value.
 	 * \tparam threshold the maximum number of digits in the string
@@ -96,11 +85,59 @@ namespace floaxie
 		buffer[0] = d[0];
 		buffer[1] = d[1];
 
-		buffer[2] = '\0';
-
 		return 2 + (hundreds > 0);
 	}
 
+	/** \brief Prints exponent part of decimal exponent format in the style
+	 * specified by the options.
+	 *
+	 * \tparam Options format options (see `default_format_options`).
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer \p **buffer**.
+	 *
+	 * \param K decimal exponent value.
+	 * \param buffer character buffer to print to.
+	 * \param options format options to use.
+	 *
+	 * \return number of characters written to the buffer.
+	 */
+	template<typename Options, typename CharType> inline std::size_t print_exponent(const int K, CharType* buffer, const Options& options) noexcept
+	{
+		const unsigned int min_digits(options.exponent_digits);
+		const bool plus(options.exponent_plus);
+
+		assert(min_digits >= 1 && min_digits <= 3);
+
+		CharType* p(buffer);
+
+		*p++ = 'e';
+		*p = K < 0 ? '-' : '+';
+		p += K < 0 || plus;
+
+		unsigned int exponent(K < 0 ? -K : K);
+		const bool hundreds(exponent >= 100 || min_digits > 2);
+
+		if (hundreds)
+		{
+			*p++ = CharType('0' + exponent / 100);
+			exponent %= 100;
+		}
+
+		if (hundreds || exponent >= 10 || min_digits > 1)
+		{
+			const char* d = digits_lut + exponent * 2;
+			p[0] = d[0];
+			p[1] = d[1];
+			p += 2;
+		}
+		else
+		{
+			*p++ = CharType('0' + exponent);
+		}
+
+		return p - buffer;
+	}
+
 	/** \brief Prints exponent (*scientific*) part of value representation in
 	 * decimal exponent format.
 	 *
@@ -167,15 +204,102 @@ namespace floaxie
 		wrap::memmove(buffer + left_shift_dest, buffer + left_shift_src, left_shift_len);
 		wrap::memset(buffer, CharType('0'), left_offset);
 		wrap::memset(buffer + len, CharType('0'), right_offset);
-		buffer[actual_dot_pos] = '.';
-		buffer[term_pos] = '\0';
+
+		if (k < 0)
+			buffer[actual_dot_pos] = '.';
 
 		return term_pos;
 	}
 
+	/** \brief Calculates the number of characters `print_scientific()`
+	 * writes.
+	 *
+	 * \param len number of printed digits.
+	 * \param dot_pos number of character, where dot position should be placed.
+	 */
+	inline std::size_t scientific_length(const unsigned int len, const int dot_pos) noexcept
+	{
+		const int K = dot_pos - 1;
+		return len + /*dot*/(len > 1) + /*'e'*/1 + /*exp sign*/(K < 0) + /*exp digits*/2 + (std::abs(K) >= 100);
+	}
+
+	/** \brief Calculates the number of characters `print_decimal()` writes.
+	 *
+	 * \param len number of printed digits.
+	 * \param k decimal exponent of the value.
+	 */
+	inline std::size_t decimal_length(const unsigned int len, const int k) noexcept
+	{
+		const int dot_pos = static_cast<int>(len) + k;
+		return dot_pos > 0 ? len + positive_part(k) + (k < 0) : len + 2 - dot_pos;
+	}
+
+	/** \brief Chooses format to print the value in by \p
+	 * **decimal_scientific_threshold** value.
+	 *
+	 * \param len number of printed digits.
+	 * \param k decimal exponent of the value.
+	 *
+	 * \see `choose_format()`
+	 */
+	template<std::size_t decimal_scientific_threshold>
+	inline format choose_format(const unsigned int len, const int k) noexcept
+	{
+		/* v = buffer * 10 ^ k
+			dot_pos is such that 10 ^ (dot_pos - 1) <= v < 10 ^ dot_pos
+			this way dot_pos gives the position of the comma.
+		*/
+		const int dot_pos = static_cast<int>(len) + k;
+
+		// is always positive, since dot_pos is negative only when k is negative
+		const std::size_t field_width = std::max(dot_pos, -k);
+
+		return choose_format<decimal_scientific_threshold>(field_width);
+	}
+
+	/** \brief Calculates the number of characters `print_format()` writes.
+	 *
+	 * \param len number of printed digits.
+	 * \param k decimal exponent of the value.
+	 * \param f format to print in.
+	 */
+	inline std::size_t format_length(const unsigned int len, const int k, const format f) noexcept
+	{
+		return f == format::decimal ? decimal_length(len, k) : scientific_length(len, static_cast<int>(len) + k);
+	}
+
+	/** \brief Formats printed digits in the specified format.
+	 *
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer \p **buffer**.
+	 *
+	 * \param buffer character buffer with printed digits, which should have
+	 * room for at least `format_length()` characters.
+	 * \param len length of current representation in \p **buffer**.
+	 * \param k decimal exponent of the value.
+	 * \param f format to print in.
+	 *
+	 * \return number of characters written to the buffer.
+	 */
+	template<typename CharType> inline std::size_t print_format(CharType* buffer, const unsigned int len, const int k, const format f) noexcept
+	{
+		switch (f)
+		{
+		case format::decimal:
+			return print_decimal(buffer, len, k);
+
+		case format::scientific:
+			return print_scientific(buffer, len, static_cast<int>(len) + k);
+		}
+
+		// never reach here
+		return 0;
+	}
+
 	/** \brief Makes final format corrections to have the string representation
 	 * be properly and pretty printed (with decimal point in place, exponent
-	 * part, where appropriate etc.).
+	 * part, where appropriate etc.). The representation isn't
+	 * null-terminated.
 	 *
 	 * \tparam decimal_scientific_threshold the maximum number of digits in the
 	 * string representation, when decimal format can be used (otherwise
@@ -195,27 +319,212 @@ namespace floaxie
 	template<std::size_t decimal_scientific_threshold, typename CharType>
 	inline std::size_t prettify(CharType* buffer, const unsigned int len, const int k) noexcept
 	{
-		/* v = buffer * 10 ^ k
-			dot_pos is such that 10 ^ (dot_pos - 1) <= v < 10 ^ dot_pos
-			this way dot_pos gives the position of the comma.
-		*/
-		const int dot_pos = static_cast<int>(len) + k;
+		return print_format(buffer, len, k, choose_format<decimal_scientific_threshold>(len, k));
+	}
 
-		// is always positive, since dot_pos is negative only when k is negative
-		const std::size_t field_width = std::max(dot_pos, -k);
+	/** \brief Digit writer (see `plain_digit_writer`), which puts the digits
+	 * right to their final positions in the representation `prettify()`
+	 * would make of them.
+	 *
+	 * The format is chosen by the position of decimal point, which is known
+	 * before the first digit is generated, so decimal point, leading zeros
+	 * and the like are written along with the digits and the digits are never
+	 * moved afterwards. The only exception is decimal format, which turns out
+	 * to have too many digits for it: the layout is dropped then and the
+	 * digits are formatted in decimal exponent format by `finish()`.
+	 *
+	 * \tparam Options format options (`default_format_options`, the ones
+	 * derived from it or `format_options`).
+	 * \tparam CharType character type (typically `char` or `wchar_t`) of the
+	 * output buffer.
+	 */
+	template<typename Options, typename CharType> class layout_digit_writer
+	{
+	public:
+		/** \brief Constructs writer to the specified buffer (the options
+		 * should outlive the writer).
+		 */
+		layout_digit_writer(CharType* buffer, const Options& options) noexcept :
+			m_buffer(buffer), m_pos(buffer), m_length(0), m_dot_pos(0), m_split(-1), m_limit(std::numeric_limits<int>::max()), m_layout(layout::plain), m_options(&options) { }
 
-		switch (choose_format<decimal_scientific_threshold>(field_width))
+		/** \brief Chooses the layout by decimal point position. */
+		void start(const int dot_pos) noexcept
 		{
-		case format::decimal:
-			return print_decimal(buffer, len, k);
+			const int threshold(m_options->scientific_threshold);
 
-		case format::scientific:
-			return print_scientific(buffer, len, dot_pos);
+			m_dot_pos = dot_pos;
+
+			if (dot_pos > threshold || dot_pos <= -threshold)
+			{
+				m_layout = layout::scientific;
+				m_split = 1;
+			}
+			else if (dot_pos > 0)
+			{
+				m_layout = layout::decimal;
+				m_split = dot_pos;
+				m_limit = threshold + dot_pos;
+			}
+			else
+			{
+				m_layout = layout::leading_zeros;
+				m_limit = threshold + dot_pos;
+
+				m_buffer[0] = '0';
+				m_buffer[1] = '.';
+				wrap::memset(m_buffer + 2, CharType('0'), -dot_pos);
+				m_pos = m_buffer + 2 - dot_pos;
+			}
 		}
 
-		// never reach here
-		return 0;
-	}
+		/** \brief Writes one digit. */
+		void put(const unsigned char d) noexcept
+		{
+			if (m_length == m_limit)
+				drop_layout();
+
+			if (m_length == m_split)
+				*m_pos++ = '.';
+
+			*m_pos++ = CharType('0' + d);
+			++m_length;
+		}
+
+		/** \brief Writes \p **count** digits of \p **value** (see
+		 * `print_digits()`).
+		 */
+		void put_digits(std::uint32_t value, const unsigned int count) noexcept
+		{
+			constexpr std::uint32_t pows[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+			const int end(m_length + int(count));
+
+			if (end > m_limit)
+				drop_layout();
+
+			if (m_split >= m_length && m_split < end)
+			{
+				const unsigned int low_count(end - m_split);
+				const std::uint32_t high(value / pows[low_count]);
+
+				write_digits(high, count - low_count);
+
+				*m_pos++ = '.';
+
+				value -= high * pows[low_count];
+				write_digits(value, low_count);
+			}
+			else
+			{
+				write_digits(value, count);
+			}
+
+			m_length = end;
+		}
+
+		/** \brief Decrements the last digit written. */
+		void decrement_last() noexcept
+		{
+			--m_pos[-1];
+		}
+
+		/** \brief Discards all the digits written. */
+		void reset() noexcept
+		{
+			*this = layout_digit_writer(m_buffer, *m_options);
+		}
+
+		/** \brief Finishes the representation.
+		 *
+		 * \param K decimal exponent of the value.
+		 *
+		 * \return number of characters written to the buffer.
+		 */
+		std::size_t finish(const int K) noexcept
+		{
+			switch (m_layout)
+			{
+			case layout::scientific:
+				m_pos += print_exponent(m_dot_pos - 1, m_pos, *m_options);
+				return m_pos - m_buffer;
+
+			case layout::decimal:
+				if (m_length < m_dot_pos)
+				{
+					wrap::memset(m_pos, CharType('0'), m_dot_pos - m_length);
+					m_pos += m_dot_pos - m_length;
+				}
+
+				if (m_options->force_decimal_point && m_length <= m_dot_pos)
+				{
+					m_pos[0] = '.';
+					m_pos[1] = '0';
+					m_pos += 2;
+				}
+
+				return m_pos - m_buffer;
+
+			case layout::leading_zeros:
+				return m_pos - m_buffer;
+
+			default:
+				// the layout is only dropped, when the digits don't fit
+				// decimal format
+				if (m_length > 1)
+				{
+					wrap::memmove(m_buffer + 2, m_buffer + 1, m_length - 1);
+					m_buffer[1] = '.';
+				}
+
+				m_pos = m_buffer + m_length + (m_length > 1);
+				m_pos += print_exponent(m_length + K - 1, m_pos, *m_options);
+
+				return m_pos - m_buffer;
+			}
+		}
+
+	private:
+		/** \brief Layout of the representation being written. */
+		enum class layout : unsigned char
+		{
+			plain, /**< Just the digits (to be formatted afterwards). */
+			scientific, /**< Decimal exponent format. */
+			decimal, /**< Decimal format of value not less, than 1. */
+			leading_zeros /**< Decimal format of value less, than 1. */
+		};
+
+		/** \brief Writes the digits at the current position. */
+		void write_digits(const std::uint32_t value, const unsigned int count) noexcept
+		{
+			print_digits(m_pos, value, count);
+			m_pos += count;
+		}
+
+		/** \brief Moves the digits written so far to the beginning of the
+		 * buffer, dropping decimal point and leading zeros.
+		 */
+		void drop_layout() noexcept
+		{
+			if (m_layout == layout::leading_zeros)
+				wrap::memmove(m_buffer, m_buffer + 2 - m_dot_pos, m_length);
+			else if (m_split >= 0 && m_length > m_split)
+				wrap::memmove(m_buffer + m_split, m_buffer + m_split + 1, m_length - m_split);
+
+			m_pos = m_buffer + m_length;
+			m_split = -1;
+			m_limit = std::numeric_limits<int>::max();
+			m_layout = layout::plain;
+		}
+
+		CharType* m_buffer;
+		CharType* m_pos;
+		int m_length;
+		int m_dot_pos;
+		int m_split;
+		int m_limit;
+		layout m_layout;
+		const Options* m_options;
+	};
 }
 
 #endif // FLOAXIE_PRETTIFY_H
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * is_eight_digits() and parse_eight_digits() functions use the approach
+ * described by Daniel Lemire in "Number Parsing at a Gigabyte per Second"
+ * paper (https://arxiv.org/abs/2101.11408)
+ */
+
+#ifndef FLOAXIE_SWAR_H
+#define FLOAXIE_SWAR_H
+
+#include <cstdint>
+#include <cstddef>
+
+#include <floaxie/bit_ops.h>
+
+namespace floaxie
+{
+	/** \brief Number of characters processed at once by SWAR
+	 * (*SIMD within a register*) functions.
+	 */
+	constexpr std::size_t swar_width(8);
+
+	/** \brief Loads \p `swar_width` characters into one integer value.
+	 *
+	 * The first character of the buffer occupies the least significant byte
+	 * of the result independently of the platform byte order.
+	 *
+	 * The function is only defined for `char`, as wider character types
+	 * don't fit the register.
+	 *
+	 * \param str character buffer of at least \p `swar_width` characters.
+	 *
+	 * \return integer value with the characters packed.
+	 */
+	inline std::uint64_t load_swar_chunk(const char* str) noexcept
+	{
+		std::uint64_t ret(0);
+
+		for (std::size_t i = 0; i < swar_width; ++i)
+			ret |= std::uint64_t(static_cast<unsigned char>(str[i])) << (8 * i);
+
+		return ret;
+	}
+
+	/** \brief Checks if all characters of the chunk are decimal digits.
+	 *
+	 * \param chunk characters packed by `load_swar_chunk()`.
+	 *
+	 * \return `true`, if all the characters are in '0'..'9' range.
+	 */
+	constexpr bool is_eight_digits(std::uint64_t chunk) noexcept
+	{
+		return ((chunk & 0xf0f0f0f0f0f0f0f0) |
+			(((chunk + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) == 0x3333333333333333;
+	}
+
+	/** \brief Converts eight decimal digits to their integer value.
+	 *
+	 * Pairs, quads and octets of digits are merged by three multiplications
+	 * instead of eight sequential ones.
+	 *
+	 * The caller should ensure, that the chunk consists of decimal digits
+	 * only (see `is_eight_digits()`), otherwise the result is meaningless.
+	 *
+	 * \param chunk characters packed by `load_swar_chunk()`.
+	 *
+	 * \return integer value of the eight digits.
+	 */
+	constexpr std::uint32_t parse_eight_digits(std::uint64_t chunk) noexcept
+	{
+		constexpr std::uint64_t mask(0x000000ff000000ff);
+		constexpr std::uint64_t mul1(100 + (std::uint64_t(1000000) << 32));
+		constexpr std::uint64_t mul2(1 + (std::uint64_t(10000) << 32));
+
+		chunk -= 0x3030303030303030;
+		chunk = (chunk * 10) + (chunk >> 8); // pairs
+		chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32; // quads and the whole
+
+		return std::uint32_t(chunk);
+	}
+
+	/** \brief Chunk of eight '0' characters, as `load_swar_chunk()` packs it. */
+	constexpr std::uint64_t zero_swar_chunk(0x3030303030303030);
+
+	/** \brief Returns the character of the chunk at the specified position
+	 * (in the order of the buffer).
+	 */
+	constexpr char swar_char(std::uint64_t chunk, std::size_t pos) noexcept
+	{
+		return static_cast<char>(chunk >> (8 * pos));
+	}
+
+	/** \brief Returns the last (in the order of the buffer) character of
+	 * the chunk.
+	 */
+	constexpr char last_swar_char(std::uint64_t chunk) noexcept
+	{
+		return swar_char(chunk, swar_width - 1);
+	}
+
+	/** \brief Counts the characters of the chunk before the first one,
+	 * which is marked by non-zero byte of \p **mismatches**.
+	 */
+	constexpr std::size_t count_leading_chars(std::uint64_t mismatches) noexcept
+	{
+		return mismatches ? std::size_t(count_trailing_zeros(mismatches)) / 8 : swar_width;
+	}
+
+	/** \brief Converts first \p **count** decimal digits of the chunk to
+	 * their integer value.
+	 *
+	 * The digits are shifted to the end of the chunk and the vacant
+	 * characters are filled by '0', so that `parse_eight_digits()` is used.
+	 *
+	 * \param chunk characters packed by `load_swar_chunk()` with at least
+	 * \p **count** first ones being decimal digits.
+	 * \param count number of digits to convert (from 1 to `swar_width`).
+	 *
+	 * \return integer value of the digits.
+	 */
+	constexpr std::uint32_t parse_leading_digits(std::uint64_t chunk, std::size_t count) noexcept
+	{
+		return parse_eight_digits(count < swar_width ?
+			(chunk << (8 * (swar_width - count))) | (zero_swar_chunk >> (8 * count)) : chunk);
+	}
+
+	/** \brief Counts decimal digits at the beginning of the chunk.
+	 *
+	 * Carries out of the bytes of the characters, which are not digits, may
+	 * spoil the check of the following ones, but they aren't counted anyway.
+	 *
+	 * \param chunk characters packed by `load_swar_chunk()`.
+	 *
+	 * \return number of leading characters in '0'..'9' range.
+	 */
+	constexpr std::size_t count_leading_digits(std::uint64_t chunk) noexcept
+	{
+		// non-zero bytes mark the characters, which are not digits
+		return count_leading_chars(((chunk & 0xf0f0f0f0f0f0f0f0) ^ 0x3030303030303030) |
+			(((chunk + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) ^ 0x3030303030303030));
+	}
+
+	/** \brief Counts '0' characters at the beginning of the chunk.
+	 *
+	 * \param chunk characters packed by `load_swar_chunk()`.
+	 *
+	 * \return number of leading '0' characters.
+	 */
+	constexpr std::size_t count_leading_zero_chars(std::uint64_t chunk) noexcept
+	{
+		return count_leading_chars(chunk ^ zero_swar_chunk);
+	}
+
+	/** \brief Tries to load eight characters at once.
+	 *
+	 * Only `char` buffers are supported, for other character types the
+	 * function always fails.
+	 *
+	 * \param str character buffer of at least \p `swar_width` characters.
+	 * \param chunk output parameter to put packed characters to.
+	 *
+	 * \return `true`, if the characters are loaded.
+	 */
+	template<typename CharType> inline bool load_swar_chunk(const CharType*, std::uint64_t&) noexcept
+	{
+		return false;
+	}
+
+	/** \brief `char` version of `load_swar_chunk()`. */
+	inline bool load_swar_chunk(const char* str, std::uint64_t& chunk) noexcept
+	{
+		chunk = load_swar_chunk(str);
+		return true;
+	}
+
+	/** \brief Loads the run of up to eight decimal digits from the buffer,
+	 * which end is unknown.
+	 *
+	 * The characters are read one by one up to the first one, which is not a
+	 * digit (e.g. terminating null character), so nothing after it is ever
+	 * read. Only `char` buffers are supported, for other character types no
+	 * digits are loaded.
+	 *
+	 * \param str null-terminated character buffer.
+	 * \param chunk output parameter to put packed digits to (the characters
+	 * after them are zero bytes).
+	 *
+	 * \return number of the loaded digits.
+	 */
+	template<typename CharType> inline std::size_t probe_leading_digits(const CharType*, std::uint64_t&) noexcept
+	{
+		return 0;
+	}
+
+	/** \brief `char` version of `probe_leading_digits()`. */
+	inline std::size_t probe_leading_digits(const char* str, std::uint64_t& chunk) noexcept
+	{
+		chunk = 0;
+
+		std::size_t i(0);
+		for (; i < swar_width && static_cast<unsigned int>(str[i] - '0') < 10; ++i)
+			chunk |= std::uint64_t(static_cast<unsigned char>(str[i])) << (8 * i);
+
+		return i;
+	}
+
+	/** \brief Tries to load eight decimal digits at once.
+	 *
+	 * Only `char` buffers are supported, for other character types the
+	 * function always fails.
+	 *
+	 * \param str character buffer of at least \p `swar_width` characters.
+	 * \param chunk output parameter to put packed characters to.
+	 *
+	 * \return `true`, if all loaded characters are decimal digits.
+	 */
+	template<typename CharType> inline bool load_eight_digits(const CharType*, std::uint64_t&) noexcept
+	{
+		return false;
+	}
+
+	/** \brief `char` version of `load_eight_digits()`. */
+	inline bool load_eight_digits(const char* str, std::uint64_t& chunk) noexcept
+	{
+		chunk = load_swar_chunk(str);
+		return is_eight_digits(chunk);
+	}
+}
+
+#endif // FLOAXIE_SWAR_H
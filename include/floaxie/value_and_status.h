@@ -0,0 +1,44 @@
+/*
+ * Copyright 2015-2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_VALUE_AND_STATUS_H
+#define FLOAXIE_VALUE_AND_STATUS_H
+
+#include <floaxie/conversion_status.h>
+
+namespace floaxie
+{
+	/** \brief Small decorator around returning value to help the client
+	 * optionally receive minor error states along with it.
+	 *
+	 * \tparam FloatType target floating point type to store results.
+	 */
+	template<typename FloatType> struct value_and_status
+	{
+		/** \brief The returning result value itself. */
+		FloatType value;
+		/** \brief Conversion status indicating any problems occurred. */
+		conversion_status status;
+
+		/** \brief Constructs the object with empty value and successful status. */
+		value_and_status() noexcept : value(), status(conversion_status::success) { }
+		/** \brief Default conversion operator to `FloatType` to make use of the
+		 * wrapper more transparent. */
+		operator FloatType() const noexcept { return value; }
+	};
+}
+
+#endif // FLOAXIE_VALUE_AND_STATUS_H
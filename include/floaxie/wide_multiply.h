@@ -0,0 +1,126 @@
+/*
+ * Copyright 2022 Alexey Chernov <4ernov@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOAXIE_WIDE_MULTIPLY_H
+#define FLOAXIE_WIDE_MULTIPLY_H
+
+#include <cstdint>
+
+#if !defined(FLOAXIE_NO_INTRINSICS)
+#if defined(__SIZEOF_INT128__)
+#define FLOAXIE_HAS_INT128
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#define FLOAXIE_HAS_MSVC_MULTIPLY
+#endif
+#endif
+
+namespace floaxie
+{
+	/** \brief 128-bit product of two 64-bit values. */
+	struct wide_product
+	{
+		/** \brief High 64 bits of the product. */
+		std::uint64_t high;
+
+		/** \brief Low 64 bits of the product. */
+		std::uint64_t low;
+	};
+
+	/** \brief Calculates full (not truncated) product of two 64-bit values.
+	 *
+	 * Portable implementation by means of 32-bit halves of the operands.
+	 *
+	 * \return `wide_product` structure with the product.
+	 */
+	inline wide_product portable_full_multiply(std::uint64_t lhs, std::uint64_t rhs) noexcept
+	{
+		constexpr std::uint64_t mask_half(0xffffffff);
+
+		const std::uint64_t a(lhs >> 32);
+		const std::uint64_t b(lhs & mask_half);
+		const std::uint64_t c(rhs >> 32);
+		const std::uint64_t d(rhs & mask_half);
+
+		const std::uint64_t ac(a * c);
+		const std::uint64_t bc(b * c);
+		const std::uint64_t ad(a * d);
+		const std::uint64_t bd(b * d);
+
+		const std::uint64_t middle((bd >> 32) + (ad & mask_half) + (bc & mask_half));
+
+		wide_product ret;
+		ret.high = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+		ret.low = (middle << 32) | (bd & mask_half);
+
+		return ret;
+	}
+
+	/** \brief Calculates full (not truncated) product of two 64-bit values.
+	 *
+	 * Uses 128-bit integer type or compiler intrinsics, where available
+	 * (unless `FLOAXIE_NO_INTRINSICS` is defined), falling back to
+	 * `portable_full_multiply()` otherwise.
+	 *
+	 * \return `wide_product` structure with the product.
+	 */
+	inline wide_product full_multiply(std::uint64_t lhs, std::uint64_t rhs) noexcept
+	{
+#if defined(FLOAXIE_HAS_INT128)
+		__extension__ typedef unsigned __int128 uint128_type;
+
+		const uint128_type product(uint128_type(lhs) * rhs);
+
+		wide_product ret;
+		ret.high = std::uint64_t(product >> 64);
+		ret.low = std::uint64_t(product);
+
+		return ret;
+#elif defined(FLOAXIE_HAS_MSVC_MULTIPLY) && defined(_M_X64)
+		wide_product ret;
+		ret.low = _umul128(lhs, rhs, &ret.high);
+
+		return ret;
+#elif defined(FLOAXIE_HAS_MSVC_MULTIPLY)
+		wide_product ret;
+		ret.high = __umulh(lhs, rhs);
+		ret.low = lhs * rhs;
+
+		return ret;
+#else
+		return portable_full_multiply(lhs, rhs);
+#endif
+	}
+
+	/** \brief Calculates higher half of the product of two 64-bit values,
+	 * rounded to nearest (ties are rounded up).
+	 */
+	inline std::uint64_t rounded_multiply_high(std::uint64_t lhs, std::uint64_t rhs) noexcept
+	{
+		const wide_product product(full_multiply(lhs, rhs));
+		return product.high + (product.low >> 63);
+	}
+
+	/** \brief Calculates higher half of the product of two 32-bit values,
+	 * rounded to nearest (ties are rounded up).
+	 */
+	inline std::uint32_t rounded_multiply_high(std::uint32_t lhs, std::uint32_t rhs) noexcept
+	{
+		return std::uint32_t((std::uint64_t(lhs) * rhs + (std::uint64_t(1) << 31)) >> 32);
+	}
+}
+
+#endif // FLOAXIE_WIDE_MULTIPLY_H
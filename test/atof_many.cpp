@@ -0,0 +1,75 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include "floaxie/atof.h"
+
+#include "strto.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	template<typename FloatType> bool check()
+	{
+		// the range isn't null-terminated
+		const char input[] = "1.5,2.25;3e10,-1e-400,9007199254740993.0000000000000000001,0.1,7";
+		const char* const last(input + sizeof(input) - 3);
+
+		const char* expected[] = { "1.5", "2.25", "3e10", "-1e-400", "9007199254740993.0000000000000000001", "0.1" };
+		constexpr size_t expected_count(sizeof(expected) / sizeof(expected[0]));
+
+		FloatType values[16];
+		conversion_status statuses[16];
+		const auto result = atof_many(input, last, ",;", values, statuses, 16);
+
+		if (result.count != expected_count || result.str_end != last)
+		{
+			cerr << "parsed " << result.count << " values up to " << (result.str_end - input) << endl;
+			return false;
+		}
+
+		for (size_t i = 0; i < expected_count; ++i)
+		{
+			const FloatType reference_value(strto<FloatType>(expected[i]));
+
+			if (memcmp(&values[i], &reference_value, sizeof(FloatType)))
+			{
+				cerr << expected[i] << " is parsed as " << values[i] << endl;
+				return false;
+			}
+		}
+
+		if (statuses[3] != conversion_status::underflow || statuses[0] != conversion_status::success)
+			return false;
+
+		// parsing stops at malformed value and at full array
+		const char malformed[] = "1,2,,3";
+		const auto malformed_result = atof_many(malformed, malformed + 6, ",", values, nullptr, 16);
+		if (malformed_result.count != 2 || malformed_result.str_end != malformed + 4)
+			return false;
+
+		const auto full_result = atof_many(malformed, malformed + 6, ",", values, nullptr, 1);
+		if (full_result.count != 1 || full_result.str_end != malformed + 2)
+			return false;
+
+		const char unseparated[] = "1 2";
+		const auto unseparated_result = atof_many(unseparated, unseparated + 3, ",", values, nullptr, 16);
+		if (unseparated_result.count != 1 || unseparated_result.str_end != unseparated + 1)
+			return false;
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	if (!check<double>())
+		return -1;
+
+	if (!check<float>())
+		return -2;
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+#include "floaxie/atof.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	// Krosh is unsure about these, so fallback is called
+	const char* fallback_inputs[] =
+	{
+		"9007199254740993.0000000000000000000000000000001",
+		"9007199254740993.00000000000000000000000000000000000000000000000000000000000000000000000000000000001",
+	};
+
+	const char* accurate_inputs[] =
+	{
+		"0.25",
+		"-1.5e-3",
+		"123456789012345678",
+		"1.2345689012e37",
+		"inf",
+		"nan",
+	};
+
+	bool fallback_called;
+
+	double checking_fallback(const char* str, char** str_end)
+	{
+		fallback_called = true;
+		return strtod(str, str_end);
+	}
+
+	// parses the value followed by garbage, which mustn't be taken into account
+	bool check(const char* input, bool expect_fallback)
+	{
+		const string buffer(string(input) + "12345e5");
+		const char* first = buffer.data();
+		const char* last = first + strlen(input);
+
+		fallback_called = false;
+		char* str_end;
+		const auto result = atof<double>(first, last, &str_end, checking_fallback);
+		const auto expected = strtod(input, nullptr);
+
+		if (fallback_called != expect_fallback)
+		{
+			cerr << "fallback is " << (fallback_called ? "" : "not ") << "called for " << input << endl;
+			return false;
+		}
+
+		if (str_end != last)
+		{
+			cerr << "wrong str_end for " << input << endl;
+			return false;
+		}
+
+		if (expected == expected ? result.value != expected : result.value == result.value)
+		{
+			cerr << "wrong value for " << input << ": " << result.value << " vs " << expected << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (auto input : fallback_inputs)
+	{
+		if (!check(input, true))
+			return -1;
+	}
+
+	for (auto input : accurate_inputs)
+	{
+		if (!check(input, false))
+			return -2;
+	}
+
+	// default exact fallback refines the result right in the range
+	for (auto input : fallback_inputs)
+	{
+		const string buffer(string(input) + "12345e5");
+		const char* last = buffer.data() + strlen(input);
+		char* str_end;
+		const auto result = atof<double>(buffer.data(), last, &str_end);
+
+		if (result.value != strtod(input, nullptr) || result.status != conversion_status::success || str_end != last)
+			return -6;
+	}
+
+	if (!is_exact_fallback<double, char>(exact_fallback<double, char>) || is_exact_fallback<double, char>(checking_fallback))
+		return -7;
+
+	// range ends inside of the exponent
+	const char exp_input[] = "1.5e10";
+	char* str_end;
+	if (atof<double>(exp_input, exp_input + 5, &str_end) != 15 || str_end != exp_input + 5)
+		return -3;
+
+	// empty range
+	if (atof<double>(exp_input, exp_input, &str_end).value != 0 || str_end != exp_input)
+		return -4;
+
+#if __cplusplus >= 201703L
+	const string_view sv(exp_input, 3);
+	if (from_string<double>(sv) != 1.5)
+		return -5;
+#endif
+
+	return 0;
+}
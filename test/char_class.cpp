@@ -0,0 +1,67 @@
+#include <string>
+
+#include "floaxie/char_class.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	template<typename CharType> char_class expected_class(CharType c)
+	{
+		switch (c)
+		{
+		case '0':
+			return char_class::zero;
+
+		case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+			return char_class::digit;
+
+		case '.':
+			return char_class::dot;
+
+		case '+': case '-':
+			return char_class::sign;
+
+		case 'n': case 'N':
+			return char_class::nan;
+
+		case 'i': case 'I':
+			return char_class::inf;
+
+		default:
+			return char_class::other;
+		}
+	}
+
+	template<typename CharType> bool check_all()
+	{
+		for (long code = 0; code < 0x10000; ++code)
+		{
+			const CharType c(static_cast<CharType>(code));
+			if (classify_char(c) != expected_class(c))
+				return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (int code = -128; code < 128; ++code)
+	{
+		const char c(static_cast<char>(code));
+		if (classify_char(c) != expected_class(c))
+			return -1;
+	}
+
+	// codes of wide characters, which differ from the digits by higher bits only
+	if (!check_all<wchar_t>() || !check_all<char16_t>() || !check_all<char32_t>() ||
+		classify_char(static_cast<wchar_t>(-1)) != char_class::other || classify_char(static_cast<char32_t>(0x10030)) != char_class::other)
+		return -2;
+
+	static_assert(classify_char('5') == char_class::digit, "classification is not constexpr");
+
+	return 0;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <random>
+#include <cstdint>
+
+#include "floaxie/bit_ops.h"
+#include "floaxie/diy_fp.h"
+
+using namespace std;
+using namespace floaxie;
+
+static_assert(count_leading_zeros(uint64_t(1)) == 63, "count_leading_zeros() is expected to be constexpr");
+static_assert(portable_count_leading_zeros(uint32_t(1)) == 31, "portable_count_leading_zeros() is expected to be constexpr");
+
+int main(int, char**)
+{
+	for (size_t i = 0; i < 64; ++i)
+	{
+		const uint64_t value(uint64_t(1) << i);
+
+		if (count_leading_zeros(value) != int(63 - i) || portable_count_leading_zeros(value) != int(63 - i))
+			return -1;
+
+		if (count_leading_zeros(value | (value >> 1)) != int(63 - i) || portable_count_leading_zeros(value | 1) != int(63 - i))
+			return -2;
+	}
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 100000; ++i)
+	{
+		const uint64_t value(gen() >> (i % 64));
+		const uint32_t value32(uint32_t(value >> 32) | 1);
+
+		if (!value)
+			continue;
+
+		if (count_leading_zeros(value) != portable_count_leading_zeros(value))
+			return -3;
+
+		if (count_leading_zeros(value32) != portable_count_leading_zeros(value32))
+			return -4;
+	}
+
+	// normalization of the denormalized values
+	diy_fp<double> w(numeric_limits<double>::denorm_min());
+	w.normalize();
+
+	if (w.mantissa() != msb_value<uint64_t>() || w.exponent() != -1074 - 63)
+		return -5;
+
+	return 0;
+}
@@ -0,0 +1,119 @@
+// compares SIMD scan with the portable one
+#define FLOAXIE_SIMD
+
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "floaxie/atof.h"
+#include "floaxie/digit_scan.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	bool check_scan(const string& str)
+	{
+		const auto& expected(portable_scan_digit_run(str.data(), str.data() + str.size()));
+		const auto& result(scan_digit_run(str.data(), str.data() + str.size()));
+
+		if (result.digits != expected.digits || result.dot != expected.dot || result.exponent != expected.exponent || result.fraction != expected.fraction)
+		{
+			cerr << "\"" << str << "\" is scanned as " << result.digits << ", " << result.dot << ", " << result.exponent << ", " << result.fraction <<
+				" instead of " << expected.digits << ", " << expected.dot << ", " << expected.exponent << ", " << expected.fraction << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename FloatType> bool check_parse(const string& str)
+	{
+		// null-terminated strings are parsed character by character
+		char* expected_end;
+		const auto& expected(atof<FloatType>(str.c_str(), &expected_end));
+
+		char* str_end;
+		const auto& result(atof<FloatType>(str.data(), str.data() + str.size(), &str_end));
+
+		if (result.value != expected.value || result.status != expected.status || str_end != expected_end)
+		{
+			cerr << str << " is parsed in range as " << result.value << " of length " << str_end - str.data() << " instead of " << expected.value <<
+				" of length " << expected_end - str.data() << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	const digit_scan_result cases[] =
+	{
+		{ 16, 16, 16, 0 }, { 0, 0, 16, 15 }, { 3, 3, 16, 12 }, { 5, 16, 5, 0 }, { 1, 1, 10, 8 }, { 2, 2, 16, 3 }, { 1, 4, 16, 0 }
+	};
+
+	const char* const strings[] =
+	{
+		"0123456789012345", ".123456789012345", "123.456789012345", "12345e1234567890", "1.23456789E12345", "12.345x6789012345", "1x23.456789012345"
+	};
+
+	for (size_t i = 0; i < sizeof(strings) / sizeof(strings[0]); ++i)
+	{
+		const auto& result(scan_digit_run(strings[i], strings[i] + digit_scan_width));
+		if (result.digits != cases[i].digits || result.dot != cases[i].dot || result.exponent != cases[i].exponent ||
+			result.fraction != cases[i].fraction || !check_scan(strings[i]))
+			return -1;
+	}
+
+	// positions are limited by the length of short buffers
+	const string short_str("123");
+	const auto& short_result(scan_digit_run(short_str.data(), short_str.data() + short_str.size()));
+	if (short_result.digits != 3 || short_result.dot != 3 || short_result.exponent != 3 || short_result.fraction != 0)
+		return -2;
+
+	const string short_fraction("12.34");
+	const auto& short_fraction_result(scan_digit_run(short_fraction.data(), short_fraction.data() + short_fraction.size()));
+	if (short_fraction_result.digits != 2 || short_fraction_result.dot != 2 || short_fraction_result.fraction != 2)
+		return -2;
+
+	const char alphabet[] = "0123456789000.eE+-x \x80\xff/:";
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 200000; ++i)
+	{
+		string str;
+		const size_t length(gen() % 24);
+
+		for (size_t j = 0; j < length; ++j)
+			str += alphabet[gen() % (sizeof(alphabet) - 1)];
+
+		if (!check_scan(str))
+			return -3;
+	}
+
+	const char number_alphabet[] = "01234567890000000009.";
+
+	for (size_t i = 0; i < 300000; ++i)
+	{
+		string str(gen() % 2 ? "-" : "");
+		const size_t length(1 + gen() % 60);
+
+		for (size_t j = 0; j < length; ++j)
+			str += number_alphabet[gen() % (sizeof(number_alphabet) - 1)];
+
+		if (gen() % 2)
+			str += "e" + to_string(int(gen() % 700) - 350);
+
+		if (gen() % 2)
+			str += "x";
+
+		if (!check_parse<double>(str) || !check_parse<float>(str))
+			return -4;
+	}
+
+	return 0;
+}
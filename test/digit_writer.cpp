@@ -0,0 +1,71 @@
+#include <iostream>
+#include <string>
+#include <random>
+#include <cstring>
+#include <cmath>
+
+#include "floaxie/ftoa.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	template<typename FloatType> bool check(FloatType v)
+	{
+		constexpr int alpha(grisu_parameters<FloatType>.alpha), gamma(grisu_parameters<FloatType>.gamma);
+
+		char expected[64];
+		int len, K;
+		grisu2<alpha, gamma>(v, expected, &len, &K);
+		const size_t expected_length(prettify<ftoa_scientific_threshold>(expected, len, K));
+
+		char buffer[64];
+		const default_format_options options;
+		layout_digit_writer<default_format_options, char> writer(buffer, options);
+		grisu2<alpha, gamma>(v, writer, &K);
+		const size_t length(writer.finish(K));
+
+		if (string(buffer, length) != string(expected, expected_length))
+		{
+			cerr << "laid out representation " << string(buffer, length) << " is not equal to " << string(expected, expected_length) << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	// all the layouts and switching between them
+	for (int e = -30; e <= 30; ++e)
+	{
+		const double p(pow(10., e));
+		const double values[] = { p, 1.5 * p, 123456789 * p, 1234567890123456.7 * p, 0.1234567890123456 * p, 3.0 / 7 * p };
+
+		for (auto v : values)
+		{
+			if (!check(v) || !check(float(v)))
+				return -1;
+		}
+	}
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 1000000; ++i)
+	{
+		const double v(double(gen() % 100000000) / double(uint64_t(1) << (i % 64)));
+		if (!check(v) || !check(float(v)))
+			return -2;
+
+		double r;
+		const uint64_t mantissa(gen() & ((uint64_t(1) << 52) - 1));
+		const uint64_t bits(mantissa | (uint64_t(1023 + int(i % 120) - 60) << 52));
+		memcpy(&r, &bits, sizeof(r));
+		if (!check(r))
+			return -3;
+	}
+
+	return 0;
+}
@@ -0,0 +1,77 @@
+#include <iostream>
+#include <string>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#include "floaxie/ftoa.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	// both engines print the closest one of the shortest representations
+	template<typename FloatType> bool check(FloatType v)
+	{
+		char buffer[max_buffer_size<FloatType>()], expected[max_buffer_size<FloatType>()];
+
+		ftoa(v, buffer, dragonbox_engine());
+		ftoa(v, expected, grisu3_engine());
+
+		if (strcmp(buffer, expected))
+		{
+			cerr << "representation of " << expected << " is " << buffer << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 1000000; ++i)
+	{
+		double v;
+		const uint64_t bits(gen() & 0xffefffffffffffff);
+		memcpy(&v, &bits, sizeof(v));
+
+		float f;
+		const uint32_t bits_f(uint32_t(gen()) & 0xff7fffff);
+		memcpy(&f, &bits_f, sizeof(f));
+
+		if (!check(v) || !check(f) || !check(double(gen() % 100000000) / 100))
+			return -1;
+	}
+
+	for (int e = -1074; e < 1024; ++e)
+	{
+		if (!check(ldexp(1., e)))
+			return -2;
+	}
+
+	for (int e = -149; e < 128; ++e)
+	{
+		if (!check(ldexp(1.f, e)))
+			return -3;
+	}
+
+	const double special_values[] = { 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 1e23, 9007199254740993., 0.3, 0., -1.5, numeric_limits<double>::infinity() };
+	for (auto v : special_values)
+	{
+		if (!check(v))
+			return -4;
+	}
+
+	// the shortest representation is not always printed by Grisu2
+	char buffer[max_buffer_size<double>()];
+	ftoa(5e-324, buffer, dragonbox_engine());
+	if (string(buffer) != "5e-324")
+		return -5;
+
+	return 0;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+#include "floaxie/eisel_lemire.h"
+
+#include "strto.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	struct test_case
+	{
+		std::uint64_t w;
+		int q;
+		// 128-bit product is not enough to decide on rounding
+		bool inexact_double;
+		bool inexact_float;
+	};
+
+	const test_case test_cases[] =
+	{
+		{ 1, 0, false, false },
+		{ 1, -343, false, false },
+		{ 1, 343, false, false },
+		{ 9007199254740993, 0, false, false }, // tie, resolved exactly
+		{ 9007199254740995, 0, false, false }, // tie, resolved exactly
+		{ 4503599627370497, 1, false, false },
+		{ 17976931348623157, 292, false, false },
+		{ 17976931348623159, 292, false, false },
+		{ 24703282292062328, -340, false, false },
+		{ 49406564584124654, -341, false, false },
+		{ 22250738585072011, -324, false, false },
+		{ 78459735791271921, 49, false, false },
+		{ 695255, 113, false, false },
+		{ 368715, -232, false, false },
+		{ 18454005, -51, false, false },
+		{ 16777217, 0, false, false }, // tie for float, resolved exactly
+		{ 34028235, 31, false, false },
+		{ 14012984, -52, false, false },
+		{ 9999999999999999999u, -20, false, false },
+		{ 15782883275999433509u, -339, true, false }, // lower half of the product is all ones
+		{ 18186497722553369805u, 80, true, false },
+		{ 14999775663049351983u, -30, true, true },
+		{ 18343440309874191887u, -59, true, true },
+	};
+
+	template<typename FloatType> bool check(const test_case& tc, bool inexact)
+	{
+		const string str(to_string(tc.w) + "e" + to_string(tc.q));
+		const auto& result = eisel_lemire<FloatType>(tc.w, tc.q);
+		const FloatType expected = strto<FloatType>(str.c_str());
+
+		if (result.is_accurate == inexact)
+		{
+			cerr << str << " is " << (inexact ? "" : "not ") << "reported accurate" << endl;
+			return false;
+		}
+
+		if (result.is_accurate && memcmp(&result.value, &expected, sizeof(FloatType)))
+		{
+			cerr << str << " is converted to " << result.value << " instead of " << expected << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (const auto& tc : test_cases)
+	{
+		if (!check<double>(tc, tc.inexact_double))
+			return -1;
+
+		if (!check<float>(tc, tc.inexact_float))
+			return -2;
+	}
+
+	return 0;
+}
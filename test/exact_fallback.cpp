@@ -0,0 +1,75 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+#include "floaxie/atof.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	const char* test_inputs[] =
+	{
+		"7.8459735791271921e+65",
+		"6.95255e118",
+		"3.68715e-227",
+		"9007199254740991.9",
+		"9007199254740993",
+		"9007199254740993.0000000000000000000000000000001",
+		"2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125e-324",
+		"2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125001e-324",
+		"1.7976931348623158e308",
+		"1.7976931348623159e308",
+		"-1e400",
+		"-1e-400",
+		"4.9e-324",
+		"3e-324",
+		"18454005e-51",
+		"0e338",
+	};
+
+	template<typename FloatType> bool check(const char* input, FloatType expected, char* expected_end)
+	{
+		char* str_end;
+		const auto result = exact_fallback<FloatType>(input, &str_end);
+
+		if (memcmp(&result.value, &expected, sizeof(FloatType)) || str_end != expected_end)
+		{
+			cerr << "conversion of " << input << " is " << result.value << " instead of " << expected << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (auto input : test_inputs)
+	{
+		char* expected_end;
+
+		const double expected = strtod(input, &expected_end);
+		if (!check(input, expected, expected_end))
+			return -1;
+
+		const float expected_f = strtof(input, &expected_end);
+		if (!check(input, expected_f, expected_end))
+			return -2;
+	}
+
+	// exact fallback is the default one and doesn't touch errno
+	errno = 0;
+	const auto result = atof<double>("2.4703282292062328e-324", nullptr);
+	if (result.value != numeric_limits<double>::denorm_min() || result.status != conversion_status::success || errno)
+		return -3;
+
+	const auto result_f = atof<float>("1e-50", nullptr);
+	if (result_f.value != 0 || result_f.status != conversion_status::underflow || errno)
+		return -4;
+
+	return 0;
+}
@@ -0,0 +1,55 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include "floaxie/krosh.h"
+
+#include "strto.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	const char* test_inputs[] =
+	{
+		"123.45",
+		"0.001",
+		"-0.3",
+		"16777215",
+		"9007199254740991",
+		"1e22",
+		"1e-22",
+		"4.9e10",
+		"7e-10",
+		"2.718281828",
+	};
+
+	template<typename FloatType> bool check(const char* input)
+	{
+		const auto& result = krosh<FloatType>(input);
+		const FloatType expected = strto<FloatType>(input);
+
+		if (!result.is_accurate || memcmp(&result.value, &expected, sizeof(FloatType)))
+		{
+			cerr << input << " is converted to " << result.value << " instead of " << expected << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (auto input : test_inputs)
+	{
+		if (!check<double>(input))
+			return -1;
+
+		if (!check<float>(input))
+			return -2;
+	}
+
+	return 0;
+}
@@ -0,0 +1,146 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstring>
+#include <cstdlib>
+
+#include "floaxie/ftoa.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	struct python_options : default_format_options
+	{
+		static constexpr bool exponent_plus = true;
+	};
+
+	struct column_options : default_format_options
+	{
+		static constexpr std::size_t scientific_threshold = 20;
+		static constexpr unsigned int exponent_digits = 3;
+		static constexpr bool force_decimal_point = true;
+	};
+
+	template<typename Options> bool check(double v, const Options& options, const char* expected)
+	{
+		vector<char> buffer(max_buffer_size<double>(options));
+		const size_t length(ftoa_format(v, buffer.data(), options, grisu3_engine()));
+
+		if (string(buffer.data()) != expected || length != strlen(expected))
+		{
+			cerr << expected << " is printed as " << buffer.data() << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename Options> bool check_same(double v, const Options& options, const format_options& runtime)
+	{
+		vector<char> expected(max_buffer_size<double>(options)), buffer(max_buffer_size<double>(runtime));
+		ftoa_format(v, expected.data(), options);
+		ftoa_format(v, buffer.data(), runtime);
+
+		if (string(buffer.data()) != expected.data())
+		{
+			cerr << "runtime options print " << buffer.data() << " instead of " << expected.data() << endl;
+			return false;
+		}
+
+		if (strtod(buffer.data(), nullptr) != v)
+		{
+			cerr << v << " is printed as " << buffer.data() << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	const double inf(numeric_limits<double>::infinity()), nan(numeric_limits<double>::quiet_NaN());
+
+	const default_format_options defaults;
+
+	if (!check(1e16, defaults, "1e16") || !check(1e-17, defaults, "1e-17") || !check(5., defaults, "5") || !check(inf, defaults, "inf") ||
+		!check(-inf, defaults, "-inf") || !check(nan, defaults, "nan"))
+		return -1;
+
+	const python_options python;
+
+	if (!check(1e16, python, "1e+16") || !check(1.5e300, python, "1.5e+300") || !check(1e-17, python, "1e-17") || !check(123., python, "123"))
+		return -2;
+
+	const column_options column;
+
+	if (!check(5., column, "5.0") || !check(-5., column, "-5.0") || !check(0., column, "0.0") || !check(1e19, column, "10000000000000000000.0") ||
+		!check(1e20, column, "1e020") || !check(0.5, column, "0.5") || !check(1.25e-30, column, "1.25e-030"))
+		return -3;
+
+	format_options json;
+	json.nan = "null";
+	json.infinity = "null";
+	json.negative_infinity = "null";
+	json.exponent_digits = 1;
+	json.scientific_threshold = 5;
+
+	if (!check(nan, json, "null") || !check(-inf, json, "null") || !check(12345., json, "12345") || !check(123456., json, "1.23456e5") ||
+		!check(1e-5, json, "0.00001") || !check(1e-6, json, "1e-6") || !check(0.000123, json, "1.23e-4") || !check(1.5e-300, json, "1.5e-300"))
+		return -4;
+
+	format_options runtime_defaults;
+
+	format_options runtime_column;
+	runtime_column.scientific_threshold = column_options::scientific_threshold;
+	runtime_column.exponent_digits = column_options::exponent_digits;
+	runtime_column.force_decimal_point = column_options::force_decimal_point;
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 300000; ++i)
+	{
+		double r;
+		const uint64_t bits(gen() & ((uint64_t(1) << 63) - 1));
+		memcpy(&r, &bits, sizeof(r));
+
+		if (!isfinite(r))
+			continue;
+
+		// default options are the ones of ftoa()
+		char expected[max_buffer_size<double>()], buffer[max_buffer_size<double>()];
+		ftoa(r, expected);
+		ftoa_format(r, buffer, runtime_defaults);
+
+		if (string(buffer) != expected)
+		{
+			cerr << "default options print " << buffer << " instead of " << expected << endl;
+			return -5;
+		}
+
+		const double scaled(double(gen() % 100000000) / double(uint64_t(1) << (i % 64)));
+		if (!check_same(scaled, column, runtime_column) || !check_same(r, column, runtime_column))
+			return -6;
+
+		format_options runtime_threshold;
+		runtime_threshold.scientific_threshold = i % 25;
+		runtime_threshold.exponent_digits = 1 + i % 3;
+		runtime_threshold.exponent_plus = i % 2;
+		runtime_threshold.force_decimal_point = i % 5 == 0;
+
+		vector<char> threshold_buffer(max_buffer_size<double>(runtime_threshold));
+		ftoa_format(scaled, threshold_buffer.data(), runtime_threshold);
+
+		if (strtod(threshold_buffer.data(), nullptr) != scaled)
+		{
+			cerr << scaled << " is printed as " << threshold_buffer.data() << endl;
+			return -7;
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <system_error>
+
+#include "floaxie/charconv.h"
+
+#include "strto.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	struct test_case
+	{
+		const char* str;
+		floaxie::chars_format fmt;
+		size_t length;
+		errc ec;
+	};
+
+	const test_case test_cases[] =
+	{
+		{ "123.45", floaxie::chars_format::general, 6, errc() },
+		{ "-1.5e3", floaxie::chars_format::general, 6, errc() },
+		{ "1.5e3", floaxie::chars_format::fixed, 3, errc() },
+		{ "1.5e3", floaxie::chars_format::scientific, 5, errc() },
+		{ "1.5", floaxie::chars_format::scientific, 0, errc::invalid_argument },
+		{ "+1.5", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ "abc", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ "", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ "inf", floaxie::chars_format::scientific, 3, errc() },
+		{ "-nan", floaxie::chars_format::fixed, 4, errc() },
+		{ "1e400", floaxie::chars_format::general, 5, errc::result_out_of_range },
+		{ "-1e-400", floaxie::chars_format::general, 7, errc::result_out_of_range },
+		{ "2.4703282292062328e-324", floaxie::chars_format::general, 23, errc() },
+		{ "9007199254740993.0000000000000000000000000000001", floaxie::chars_format::general, 48, errc() },
+		{ "1e10", floaxie::chars_format::hex, 0, errc::invalid_argument },
+		{ "-", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ "-x", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ ".", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ ".e5", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ "-.", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ "-.e", floaxie::chars_format::fixed, 0, errc::invalid_argument },
+		{ "nx", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ "-in", floaxie::chars_format::general, 0, errc::invalid_argument },
+		{ ".5", floaxie::chars_format::fixed, 2, errc() },
+		{ "-.5e1", floaxie::chars_format::general, 5, errc() },
+		{ "-0.", floaxie::chars_format::fixed, 3, errc() },
+	};
+
+	template<typename FloatType> bool check(const test_case& tc)
+	{
+		const FloatType initial(FloatType(42));
+		FloatType value(initial);
+
+		// the range isn't null-terminated
+		const char* const last(tc.str + strlen(tc.str));
+		string buffer(tc.str, last);
+		buffer += "999";
+		const char* const first(buffer.data());
+
+		const auto result = floaxie::from_chars(first, first + (last - tc.str), value, tc.fmt);
+
+		if (result.ptr != first + tc.length)
+		{
+			cerr << tc.str << " is parsed up to " << (result.ptr - first) << " instead of " << tc.length << endl;
+			return false;
+		}
+
+		if (result.ec != errc() && value != initial)
+		{
+			cerr << tc.str << " modified the value in case of error" << endl;
+			return false;
+		}
+
+		if (is_same<FloatType, double>::value && result.ec != tc.ec)
+		{
+			cerr << tc.str << " is parsed with unexpected error code" << endl;
+			return false;
+		}
+
+		if (result.ec == errc())
+		{
+			const string parsed(tc.str, tc.length);
+			const FloatType expected = strto<FloatType>(parsed.c_str());
+
+			if (memcmp(&value, &expected, sizeof(FloatType)) && !(std::isnan(value) && std::isnan(expected)))
+			{
+				cerr << tc.str << " is converted to " << value << " instead of " << expected << endl;
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (const auto& tc : test_cases)
+	{
+		if (!check<double>(tc))
+			return -1;
+
+		if (!check<float>(tc))
+			return -2;
+	}
+
+	const wchar_t wstr[] = L"0.25";
+	double value;
+	const auto result = floaxie::from_chars(wstr, wstr + 4, value);
+	if (result.ptr != wstr + 4 || result.ec != errc() || value != 0.25)
+		return -3;
+
+#ifdef FLOAXIE_HAS_STD_CHARS_FORMAT
+	const char str[] = "1e5";
+	const auto std_result = floaxie::from_chars(str, str + 3, value, std::chars_format::fixed);
+	if (std_result.ptr != str + 1 || std_result.ec != errc() || value != 1)
+		return -4;
+#endif
+
+	return 0;
+}
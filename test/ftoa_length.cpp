@@ -0,0 +1,119 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include <limits>
+#include <cstring>
+
+#include "floaxie/ftoa.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	template<typename Engine, typename FloatType> bool check(FloatType v)
+	{
+		char buffer[max_buffer_size<FloatType>()];
+		const size_t expected(ftoa(v, buffer, Engine()));
+		const size_t length(ftoa_length(v, Engine()));
+
+		if (length != expected)
+		{
+			cerr << "length of " << buffer << " is calculated as " << length << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	template<typename FloatType> bool check(FloatType v)
+	{
+		return check<grisu2_engine>(v) && check<grisu3_engine>(v) && check<dragonbox_engine>(v);
+	}
+
+	template<typename FloatType> bool check_many(const vector<FloatType>& values)
+	{
+		vector<char> buffer(values.size() * max_buffer_size<FloatType>() + 1);
+		const size_t expected(ftoa_many(values.data(), values.data() + values.size(), buffer.data(), ',') - buffer.data());
+
+		vector<size_t> lengths(values.size());
+		const size_t length(ftoa_many_length(values.data(), values.data() + values.size(), lengths.data()));
+
+		if (length != expected || ftoa_many_length(values.data(), values.data() + values.size()) != expected)
+		{
+			cerr << "length of " << values.size() << " values is calculated as " << length << " instead of " << expected << endl;
+			return false;
+		}
+
+		// the values are printed to the offsets calculated by the lengths
+		size_t offset(0);
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			char value[max_buffer_size<FloatType>()];
+			ftoa(values[i], value);
+
+			if (strncmp(buffer.data() + offset, value, lengths[i]) != 0)
+			{
+				cerr << value << " is not found at offset " << offset << endl;
+				return false;
+			}
+
+			offset += lengths[i] + 1;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	const double specials[] = { 0., -0., numeric_limits<double>::infinity(), -numeric_limits<double>::infinity(), numeric_limits<double>::quiet_NaN(),
+		numeric_limits<double>::denorm_min(), numeric_limits<double>::min(), numeric_limits<double>::max() };
+
+	for (auto v : specials)
+	{
+		if (!check(v) || !check(-v) || !check(float(v)))
+			return -1;
+	}
+
+	// all the layouts and the thresholds between them
+	for (int e = -30; e <= 30; ++e)
+	{
+		const double p(pow(10., e));
+		const double values[] = { p, 1.5 * p, 123456789 * p, 1234567890123456.7 * p, 0.1234567890123456 * p, 3.0 / 7 * p };
+
+		for (auto v : values)
+		{
+			if (!check(v) || !check(-v) || !check(float(v)))
+				return -2;
+		}
+	}
+
+	mt19937_64 gen(1);
+	vector<double> doubles;
+	vector<float> floats;
+
+	for (size_t i = 0; i < 200000; ++i)
+	{
+		double r;
+		const uint64_t bits(gen());
+		memcpy(&r, &bits, sizeof(r));
+
+		float f;
+		const uint32_t float_bits(gen() & 0xffffffff);
+		memcpy(&f, &float_bits, sizeof(f));
+
+		const double price(double(gen() % 100000000) / 100);
+
+		if (!check(r) || !check(f) || !check(price))
+			return -3;
+
+		doubles.push_back(i % 2 ? r : price);
+		floats.push_back(f);
+	}
+
+	if (!check_many(doubles) || !check_many(floats) || !check_many(vector<double>()) || !check_many(vector<double>(1, 0.1)))
+		return -4;
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <limits>
+
+#include "floaxie/ftoa.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	template<typename FloatType> bool check(const vector<FloatType>& values)
+	{
+		string expected;
+		char buffer[max_buffer_size<FloatType>()];
+
+		for (auto v : values)
+		{
+			if (!expected.empty())
+				expected += ';';
+
+			ftoa(v, buffer);
+			expected += buffer;
+		}
+
+		string result(values.size() * max_buffer_size<FloatType>() + 1, '#');
+		char* const end(ftoa_many(values.data(), values.data() + values.size(), &result[0], ';'));
+
+		if (*end != '#')
+		{
+			cerr << "extra characters are written after the values" << endl;
+			return false;
+		}
+
+		result.resize(end - result.data());
+
+		if (result != expected)
+		{
+			cerr << "values are printed as " << result << " instead of " << expected << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	vector<double> values { 0.1, -0.0, numeric_limits<double>::quiet_NaN(), -numeric_limits<double>::infinity(), 1e300, -5e-324, 123 };
+
+	default_random_engine gen(1);
+	uniform_real_distribution<double> dis(-1e6, 1e6);
+
+	for (size_t i = 0; i < 1000; ++i)
+		values.push_back(dis(gen));
+
+	if (!check(values))
+		return -1;
+
+	const vector<float> float_values { 0.1f, numeric_limits<float>::infinity(), 3.4e38f, -1e-45f };
+
+	if (!check(float_values))
+		return -2;
+
+	if (!check(vector<double>()) || !check(vector<double> { 2.5 }))
+		return -3;
+
+	return 0;
+}
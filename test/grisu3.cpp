@@ -0,0 +1,113 @@
+#include <iostream>
+#include <string>
+#include <random>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+
+#include "floaxie/ftoa.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	// checks the representation is the closest one of the shortest ones
+	bool check(double v)
+	{
+		char digits[32];
+		plain_digit_writer<char> writer(digits);
+		int K;
+
+		grisu3_engine::generate(v, writer, &K);
+
+		const int length(writer.length());
+		const int exponent(K + length - 1);
+
+		const string representation(string(digits, length) + "e" + to_string(K));
+
+		// printf() rounds to the closest representation of the precision
+		char expected[64];
+		snprintf(expected, sizeof(expected), "%.*e", length - 1, v);
+
+		if (strtod(representation.c_str(), nullptr) != v)
+		{
+			cerr << representation << " is not the representation of " << expected << endl;
+			return false;
+		}
+
+		// at the powers of 2 the closest representation may be out of the
+		// narrower half of the rounding interval, while another one is in
+		int binary_exponent;
+		if (frexp(v, &binary_exponent) == 0.5)
+			return true;
+
+		string expected_digits(expected, strchr(expected, 'e'));
+		if (length > 1)
+			expected_digits.erase(1, 1);
+
+		if (string(digits, length) != expected_digits || atoi(strchr(expected, 'e') + 1) != exponent)
+		{
+			cerr << "representation of " << expected << " is " << representation << endl;
+			return false;
+		}
+
+		if (length > 1)
+		{
+			char shorter[64];
+			snprintf(shorter, sizeof(shorter), "%.*e", length - 2, v);
+
+			if (strtod(shorter, nullptr) == v)
+			{
+				cerr << "representation of " << expected << " is not the shortest one" << endl;
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 1000000; ++i)
+	{
+		double v;
+		const uint64_t bits(gen() & 0x7fefffffffffffff);
+		memcpy(&v, &bits, sizeof(v));
+
+		if (v != 0 && !check(v))
+			return -1;
+	}
+
+	for (int e = -1074; e < 1024; ++e)
+	{
+		if (!check(ldexp(1., e)))
+			return -2;
+	}
+
+	const double special_values[] = { 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 1e23, 9007199254740993., 0.3 };
+	for (auto v : special_values)
+	{
+		if (!check(v))
+			return -3;
+	}
+
+	// Grisu3 engine output is never longer, than the one of Grisu2
+	char buffer2[max_buffer_size<double>()], buffer3[max_buffer_size<double>()];
+	for (size_t i = 0; i < 1000000; ++i)
+	{
+		const double v(double(gen() % 1000000000) / double(uint64_t(1) << (i % 60)));
+
+		if (ftoa(v, buffer3, grisu3_engine()) > ftoa(v, buffer2) || strtod(buffer3, nullptr) != v)
+		{
+			cerr << buffer3 << " is longer, than " << buffer2 << endl;
+			return -4;
+		}
+	}
+
+	return 0;
+}
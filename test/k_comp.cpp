@@ -0,0 +1,59 @@
+#include <iostream>
+#include <cmath>
+
+#include "floaxie/k_comp.h"
+#include "floaxie/grisu.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	template<int alpha, int gamma> int reference_k_comp_exp(int e)
+	{
+		return static_cast<int>((alpha - e - 1) * log10(2.) + (e + 1 < alpha));
+	}
+
+	// checks the whole range of binary exponents of normalized `diy_fp` values
+	template<typename FloatType> bool check()
+	{
+		constexpr int alpha(grisu_parameters<FloatType>.alpha), gamma(grisu_parameters<FloatType>.gamma);
+		constexpr int mantissa_size(bit_size<typename diy_fp<FloatType>::mantissa_storage_type>());
+
+		const int min_e(numeric_limits<FloatType>::min_exponent - numeric_limits<FloatType>::digits - mantissa_size - 1);
+		const int max_e(numeric_limits<FloatType>::max_exponent - mantissa_size + 1);
+
+		for (int e = min_e; e <= max_e; ++e)
+		{
+			const int k(k_comp_exp<alpha, gamma>(e));
+
+			if (k != reference_k_comp_exp<alpha, gamma>(e))
+			{
+				cerr << "k_comp_exp(" << e << ") is " << k << " instead of " << reference_k_comp_exp<alpha, gamma>(e) << endl;
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (int n = -2620; n <= 2620; ++n)
+	{
+		if (floor_log10_pow2(n) != static_cast<int>(floor(n * log10(2.0L))))
+		{
+			cerr << "floor_log10_pow2(" << n << ") is wrong" << endl;
+			return -1;
+		}
+	}
+
+	if (!check<double>())
+		return -2;
+
+	if (!check<float>())
+		return -3;
+
+	return 0;
+}
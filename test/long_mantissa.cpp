@@ -0,0 +1,102 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <cerrno>
+#include <system_error>
+
+#include "floaxie/atof.h"
+#include "floaxie/charconv.h"
+
+#include "strto.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	template<typename FloatType> bool check(const string& str)
+	{
+		char* expected_end;
+		errno = 0;
+		const FloatType expected(strto<FloatType>(str.c_str(), &expected_end));
+		const bool out_of_range(errno == ERANGE && (expected == 0 || std::isinf(expected)));
+		const errc expected_ec(out_of_range ? errc::result_out_of_range : errc());
+
+		char* str_end;
+		const FloatType value(atof<FloatType>(str.c_str(), &str_end));
+
+		if (str_end != expected_end || value != expected)
+		{
+			cerr << str.substr(0, 40) << "... of length " << str.size() << " is parsed as " << value << " of length " << str_end - str.c_str() <<
+				" instead of " << expected << " of length " << expected_end - str.c_str() << endl;
+			return false;
+		}
+
+		// the same with the end of the buffer known
+		const FloatType ranged_value(atof<FloatType>(str.c_str(), str.c_str() + str.size(), &str_end));
+		if (str_end != expected_end || ranged_value != expected)
+		{
+			cerr << str.substr(0, 40) << "... of length " << str.size() << " is parsed in range as " << ranged_value << " of length " << str_end - str.c_str() << endl;
+			return false;
+		}
+
+		FloatType from_chars_value(0);
+		const auto& result(floaxie::from_chars(str.data(), str.data() + str.size(), from_chars_value));
+		if (result.ec != expected_ec || result.ptr != expected_end || (expected_ec == errc() && from_chars_value != expected))
+		{
+			cerr << str.substr(0, 40) << "... of length " << str.size() << " is parsed by from_chars() as " << from_chars_value << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool check(const string& str)
+	{
+		return check<double>(str) && check<float>(str);
+	}
+}
+
+int main(int, char**)
+{
+	const size_t lengths[] = { 2040, 2048, 2049, 2056, 5000, 100000 };
+
+	for (auto length : lengths)
+	{
+		// long runs of zeros around significant digits
+		if (!check("1" + string(length, '0')) || !check("1" + string(length, '0') + "e-" + to_string(length)) ||
+			!check("0." + string(length, '0') + "1e" + to_string(length)) || !check(string(length, '0') + "1.5") ||
+			!check("1." + string(length, '0') + "1") || !check("1" + string(length, '0') + ".5e-" + to_string(length + 10)))
+			return -1;
+
+		// halfway cases are decided by the very last digit of the tail
+		if (!check("9007199254740993" + string(length, '0')) || !check("9007199254740993" + string(length, '0') + "1") ||
+			!check("9007199254740993." + string(length, '0') + "1") || !check("2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125" + string(length, '0') + "1"))
+			return -2;
+
+		// digits, which don't fit the mantissa, followed by a tail
+		if (!check("0.1234567890123456789" + string(length, '5') + "x") || !check(string(length, '9') + "e-" + to_string(length)) ||
+			!check("-" + string(length, '7') + "." + string(length, '3')) || !check(string(length, '1') + "e400"))
+			return -3;
+	}
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		const size_t length(2000 + gen() % 3000);
+
+		string str(to_string(gen() % 10) + ".");
+		for (size_t j = 0; j < length; ++j)
+			str += gen() % 4 ? '0' : char('0' + gen() % 10);
+
+		str += "e" + to_string(int(gen() % 700) - 350);
+
+		if (!check(str))
+			return -4;
+	}
+
+	return 0;
+}
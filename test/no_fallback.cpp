@@ -0,0 +1,118 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#include "floaxie/atof.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	size_t inexact_count(0);
+
+	bool same(double lhs, double rhs)
+	{
+		return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+	}
+
+	bool check(const string& str)
+	{
+		char* expected_end;
+		const double expected(strtod(str.c_str(), &expected_end));
+
+		char* str_end;
+		const auto& result(atof<double>(str.c_str(), &str_end, no_fallback()));
+
+		char* ranged_end;
+		const auto& ranged_result(atof<double>(str.data(), str.data() + str.size(), &ranged_end, no_fallback()));
+
+		if (str_end != expected_end || ranged_end != expected_end || !same(result.value, ranged_result.value) || result.status != ranged_result.status)
+		{
+			cerr << str << " is parsed to " << result.value << " of length " << str_end - str.c_str() << " instead of length " << expected_end - str.c_str() << endl;
+			return false;
+		}
+
+		if (result.status == conversion_status::inexact)
+		{
+			// approximate result is at most one unit in the last place off
+			++inexact_count;
+
+			if (result.value != expected && nextafter(result.value, expected) != expected)
+			{
+				cerr << str << " is parsed to " << result.value << " instead of " << expected << endl;
+				return false;
+			}
+		}
+		else if (!same(result.value, expected))
+		{
+			cerr << str << " is parsed to " << result.value << " instead of " << expected << " with no inexact status" << endl;
+			return false;
+		}
+
+		// accurate results are the same, as the ones of default fallback
+		const auto& exact(atof<double>(str.c_str(), nullptr));
+		if (result.status != conversion_status::inexact && (!same(exact.value, result.value) || exact.status != result.status))
+			return false;
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	// halfway cases, which need all the digits to be rounded correctly
+	const char* const halfway[] =
+	{
+		"9007199254740993.00000000000000000001", "9007199254740992.99999999999999999999",
+		"2.4703282292062327208828439643411068618252990130716238221279284125033775363510437593264991818081799618989828234772285886546332835517796989819938739800539093906315035659515570226392290858392449105184435931802849936536152500319370457678249219365623669863658480757001585769269903706311928279558551332927834338409351978015531246597263579574622766465272827220056374006485499977096599470454020828166226237857393450736339007967761930577506740176324673600968951340535537458516661134223766678604162159680461914467291840300530057530849048765391711386591646239524912623653881879636239373280423891018672348497668235089863388587925628302755995657524455507255189313690836254779186948667994968324049705821028513185451396213837722826145437693412532098591327667236328125001",
+		"1.00000000000000011102230246251565404236316680908203125000000001"
+	};
+
+	for (auto str : halfway)
+	{
+		if (!check(str))
+			return -1;
+	}
+
+	if (!inexact_count)
+		return -2;
+
+	// no fallback function is called for wide strings either
+	const wstring wstr(halfway[0], halfway[0] + strlen(halfway[0]));
+	if (atof<double>(wstr.c_str(), nullptr, no_fallback()).status != conversion_status::inexact ||
+		from_string<double>(string(halfway[0]), no_fallback()).status != conversion_status::inexact)
+		return -3;
+
+	const char* const specials[] = { "", "x", "nan", "-inf", "0", "0e5", "1e400", "1e-400", "1.5", "123456789e-5" };
+
+	for (auto str : specials)
+	{
+		if (!check(str))
+			return -4;
+	}
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 300000; ++i)
+	{
+		double r;
+		const uint64_t bits(gen() & ~(uint64_t(1) << 63));
+		memcpy(&r, &bits, sizeof(r));
+
+		if (!isfinite(r))
+			continue;
+
+		// the value with random tail of digits
+		char buffer[64];
+		snprintf(buffer, sizeof(buffer), "%.*e", int(gen() % 25), r);
+
+		if (!check(buffer))
+			return -5;
+	}
+
+	return 0;
+}
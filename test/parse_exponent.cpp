@@ -0,0 +1,110 @@
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#include "floaxie/atof.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	struct exponent_case
+	{
+		const char* str;
+		int value;
+		size_t length;
+	};
+
+	bool check(const exponent_case& c)
+	{
+		const auto& r(parse_exponent(c.str));
+		if (r.value != c.value || size_t(r.str_end - c.str) != c.length)
+		{
+			cerr << "exponent of " << c.str << " is parsed as " << r.value << " of length " << r.str_end - c.str << endl;
+			return false;
+		}
+
+		const wstring wstr(c.str, c.str + strlen(c.str));
+		const auto& wr(parse_exponent(wstr.c_str(), wstr.c_str() + wstr.size()));
+		if (wr.value != c.value || size_t(wr.str_end - wstr.c_str()) != c.length)
+		{
+			cerr << "exponent of wide " << c.str << " is parsed as " << wr.value << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool check_strtod(const char* str)
+	{
+		char* expected_end;
+		const double expected(strtod(str, &expected_end));
+
+		char* str_end;
+		const double value(atof<double>(str, &str_end));
+
+		if (str_end != expected_end || (value != expected && !(std::isnan(value) && std::isnan(expected))))
+		{
+			cerr << str << " is parsed as " << value << " of length " << str_end - str << " instead of " << expected << " of length " << expected_end - str << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	const exponent_case cases[] =
+	{
+		{ "", 0, 0 },
+		{ "x", 0, 0 },
+		{ "e", 0, 0 },
+		{ "E+", 0, 0 },
+		{ "e-", 0, 0 },
+		{ "e+-5", 0, 0 },
+		{ "ex", 0, 0 },
+		{ "e.5", 0, 0 },
+		{ "e5", 5, 2 },
+		{ "E05", 5, 3 },
+		{ "e+5", 5, 3 },
+		{ "e-5", -5, 3 },
+		{ "e308x", 308, 4 },
+		{ "e-324.5", -324, 5 },
+		{ "e0000000000000000005", 5, 20 },
+		{ "e99999", 99999, 6 },
+		{ "e-99999999", -99999999, 10 },
+		{ "e-999999999", -exponent_limit, 11 },
+		{ "e99999999999999999999999", exponent_limit, 24 }
+	};
+
+	for (const auto& c : cases)
+	{
+		if (!check(c))
+			return -1;
+	}
+
+	// the exponent is cut by the end of the range
+	const char str[] = "e123";
+	if (parse_exponent(str, str + 3).value != 12 || parse_exponent(str, str + 1).str_end != str)
+		return -2;
+
+	const char* const values[] =
+	{
+		"1e", "1e+", "1E-", "1ex", "1e5", "1e+5", "1e-5", "1e5.5", "1e+-3", "0e5", "0e", "0e-",
+		"1e0000000000000000005", "1e99999999", "1e-99999999", "1.5e1000000000000", "-2.5e-1000000000000",
+		"123e-2147483648", "1e2147483647", "1e4294967296", "0.000001e6", "100000e-5", "1e308", "1e309",
+		"2.4703282292062328e-324", "2.4703282292062327e-324", "4.9e-324e5", "nan", "infe5", ".5e1"
+	};
+
+	for (auto v : values)
+	{
+		if (!check_strtod(v))
+			return -3;
+	}
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <system_error>
+
+#include "floaxie/charconv.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	const char sentinel('#');
+
+	const char* conversion(floaxie::chars_format fmt)
+	{
+		switch (fmt)
+		{
+		case floaxie::chars_format::fixed:
+			return "%.*f";
+
+		case floaxie::chars_format::scientific:
+			return "%.*e";
+
+		default:
+			return "%.*g";
+		}
+	}
+
+	bool check(double v, floaxie::chars_format fmt, int precision)
+	{
+		vector<char> expected(max_precision_buffer_size<double>(precision));
+		snprintf(expected.data(), expected.size(), conversion(fmt), precision, v);
+
+		vector<char> buffer(max_precision_buffer_size<double>(precision));
+		const size_t length(ftoa_precision(v, buffer.data(), fmt, precision));
+
+		if (string(buffer.data()) != expected.data() || length != strlen(expected.data()))
+		{
+			cerr << "value " << string(expected.data()) << " is printed as " << string(buffer.data()) << " (" << conversion(fmt) << ", precision " << precision << ")" << endl;
+			return false;
+		}
+
+		// exactly fitting range and the one, which is one character shorter
+		buffer.assign(length + 1, sentinel);
+
+		auto result = floaxie::to_chars(buffer.data(), buffer.data() + length, v, fmt, precision);
+		if (result.ec != errc() || result.ptr != buffer.data() + length || string(buffer.data(), length) != expected.data() || buffer[length] != sentinel)
+		{
+			cerr << "to_chars() fails to print " << string(expected.data()) << endl;
+			return false;
+		}
+
+		result = floaxie::to_chars(buffer.data(), buffer.data() + length - 1, v, fmt, precision);
+		if (result.ec != errc::value_too_large)
+		{
+			cerr << "to_chars() doesn't report too short range for " << string(expected.data()) << endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool check(double v, int precision)
+	{
+		const floaxie::chars_format formats[] = { floaxie::chars_format::fixed, floaxie::chars_format::scientific, floaxie::chars_format::general };
+
+		for (auto fmt : formats)
+		{
+			if (!check(v, fmt, precision) || !check(-v, fmt, precision))
+				return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	const double specials[] = { 0., numeric_limits<double>::infinity(), numeric_limits<double>::quiet_NaN(),
+		numeric_limits<double>::denorm_min(), numeric_limits<double>::min(), numeric_limits<double>::max(), 1e308, 1e-300 };
+
+	for (auto v : specials)
+	{
+		for (int precision = -1; precision <= 40; ++precision)
+		{
+			if (!check(v, precision))
+				return -1;
+		}
+	}
+
+	// exact representations are printed in full
+	if (!check(numeric_limits<double>::denorm_min(), 1100) || !check(numeric_limits<double>::max(), 800))
+		return -2;
+
+	// halfway cases and carries
+	const double roundings[] = { 0.5, 1.5, 2.5, 0.125, 0.375, 9.5, 99.5, 999.5, 0.0625, 0.05, 0.005, 0.95, 9.995, 1e23, 5e-324 };
+
+	for (auto v : roundings)
+	{
+		for (int precision = 0; precision <= 25; ++precision)
+		{
+			if (!check(v, precision))
+				return -3;
+		}
+	}
+
+	for (int e = -30; e <= 30; ++e)
+	{
+		const double p(pow(10., e));
+		const double values[] = { p, nextafter(p, 0.), nextafter(p, 2 * p), 0.5 * p, 1.5 * p, 9.5 * p, 3.0 / 7 * p };
+
+		for (auto v : values)
+		{
+			for (int precision = 0; precision <= 20; ++precision)
+			{
+				if (!check(v, precision) || !check(double(float(v)), precision))
+					return -4;
+			}
+		}
+	}
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 30000; ++i)
+	{
+		const int precision(int(i % 21));
+
+		const double price(double(gen() % 100000000) / 100);
+		if (!check(price, precision))
+			return -5;
+
+		double r;
+		const uint64_t bits(gen() & ~(uint64_t(1) << 63));
+		memcpy(&r, &bits, sizeof(r));
+		if (isfinite(r) && !check(r, precision))
+			return -6;
+	}
+
+	// float values are printed the same way, as promoted to double
+	char buffer[max_precision_buffer_size<float>(6)];
+	ftoa_precision(0.1f, buffer, floaxie::chars_format::fixed, -1);
+	if (string(buffer) != "0.100000")
+		return -7;
+
+	ftoa_precision(3.4e38f, buffer, floaxie::chars_format::fixed, 0);
+	if (string(buffer) != "339999995214436424907732413799364296704")
+		return -8;
+
+	return 0;
+}
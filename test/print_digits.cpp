@@ -0,0 +1,65 @@
+#include <iostream>
+#include <string>
+#include <random>
+#include <cstdint>
+
+#include "floaxie/digits_lut.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	bool check(uint32_t value)
+	{
+		const string expected(to_string(value));
+
+		char buffer[16];
+		print_digits(buffer, value, expected.length());
+
+		if (string(buffer, expected.length()) != expected)
+		{
+			cerr << value << " is printed as " << string(buffer, expected.length()) << endl;
+			return false;
+		}
+
+		wchar_t wbuffer[16];
+		print_digits(wbuffer, value, expected.length());
+
+		if (wstring(wbuffer, expected.length()) != to_wstring(value))
+		{
+			cerr << value << " is printed wrong to wide character buffer" << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	for (uint32_t value = 0; value < 100000; ++value)
+	{
+		if (!check(value))
+			return -1;
+	}
+
+	mt19937 gen(1);
+
+	for (size_t i = 0; i < 100000; ++i)
+	{
+		if (!check(gen() >> (i % 32)))
+			return -2;
+	}
+
+	if (!check(4294967295u) || !check(1000000000))
+		return -3;
+
+	// the value is padded with leading zeros up to the count
+	char buffer[16];
+	print_digits(buffer, 42, 5);
+	if (string(buffer, 5) != "00042")
+		return -4;
+
+	return 0;
+}
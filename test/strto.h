@@ -0,0 +1,11 @@
+#ifndef FLOAXIE_TEST_STRTO_H
+#define FLOAXIE_TEST_STRTO_H
+
+#include <cstdlib>
+
+// reference conversion by strtof() or strtod() depending on the type
+template<typename FloatType> FloatType strto(const char* str, char** str_end = nullptr);
+template<> inline float strto<float>(const char* str, char** str_end) { return std::strtof(str, str_end); }
+template<> inline double strto<double>(const char* str, char** str_end) { return std::strtod(str, str_end); }
+
+#endif // FLOAXIE_TEST_STRTO_H
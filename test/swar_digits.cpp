@@ -0,0 +1,89 @@
+#include <array>
+#include <cstring>
+#include <iostream>
+
+#include "floaxie/krosh.h"
+#include "floaxie/swar.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	const array<const char*, 14> test_chain {{
+		"12345678",
+		"3.1415926535897932",
+		"3.14159265358979323846264",
+		"0000123400.05678900000",
+		"123456789012345678901234567890",
+		"1.2345678901234567e-35",
+		"0.00000000123456789123456789",
+		"98765432100000000000",
+		"1234567800000001",
+		"10000000.000000001",
+		"-9007199254740993",
+		"17976931348623157e292",
+		"1.7",
+		"8.10109172351e-10"
+	}};
+
+	template<typename FloatType> bool check_bounded_equals_unbounded(const char* str)
+	{
+		const auto& unbounded(parse_digits<FloatType>(str));
+		const auto& bounded(parse_digits<FloatType>(str, str + strlen(str)));
+
+		cout << str << ": " << unbounded.value << " / " << bounded.value << ", K: " << unbounded.K << " / " << bounded.K << endl;
+
+		return unbounded.value == bounded.value &&
+			unbounded.K == bounded.K &&
+			unbounded.frac == bounded.frac &&
+			unbounded.str_end == bounded.str_end &&
+			unbounded.sign == bounded.sign;
+	}
+}
+
+int main(int, char**)
+{
+	if (!is_eight_digits(load_swar_chunk("01234567")))
+		return -1;
+
+	if (is_eight_digits(load_swar_chunk("0123.567")) || is_eight_digits(load_swar_chunk("0123456e")) || is_eight_digits(load_swar_chunk("/1234567")))
+		return -2;
+
+	if (parse_eight_digits(load_swar_chunk("12345678")) != 12345678 || parse_eight_digits(load_swar_chunk("00000009")) != 9 || parse_eight_digits(load_swar_chunk("99999999")) != 99999999)
+		return -3;
+
+	if (count_leading_digits(load_swar_chunk("01234567")) != 8 || count_leading_digits(load_swar_chunk("0123.567")) != 4 ||
+		count_leading_digits(load_swar_chunk("/1234567")) != 0 || count_leading_digits(load_swar_chunk("1234567:")) != 7 ||
+		count_leading_digits(load_swar_chunk("9\xff\xff\xff\xff\xff\xff\xff")) != 1)
+		return -7;
+
+	if (count_leading_zero_chars(load_swar_chunk("00000000")) != 8 || count_leading_zero_chars(load_swar_chunk("00012345")) != 3 ||
+		count_leading_zero_chars(load_swar_chunk("10000000")) != 0)
+		return -8;
+
+	// null-terminated buffer shorter, than the chunk
+	uint64_t chunk;
+	if (probe_leading_digits("123", chunk) != 3 || parse_leading_digits(chunk, 3) != 123 ||
+		probe_leading_digits("123456789", chunk) != 8 || parse_leading_digits(chunk, 8) != 12345678 ||
+		probe_leading_digits("12.5", chunk) != 2 || probe_leading_digits("", chunk) != 0 ||
+		probe_leading_digits(L"123", chunk) != 0)
+		return -9;
+
+	for (const auto str : test_chain)
+	{
+		if (!check_bounded_equals_unbounded<double>(str))
+			return -4;
+
+		if (!check_bounded_equals_unbounded<float>(str))
+			return -5;
+	}
+
+	// bounded buffer is not read past its end
+	const char str[] = "1234567890123456789";
+	const auto& dp(parse_digits<double>(str, str + 5));
+	if (dp.value != 12345 || dp.K != 0 || dp.str_end != str + 5)
+		return -6;
+
+	return 0;
+}
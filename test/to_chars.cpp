@@ -0,0 +1,197 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <system_error>
+#include <limits>
+#include <cmath>
+
+#include "floaxie/charconv.h"
+
+#if defined(__cpp_lib_to_chars)
+#define FLOAXIE_TEST_STD_TO_CHARS
+#endif
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	const char sentinel('#');
+
+	template<typename FloatType> floaxie::to_chars_result print(char* first, char* last, FloatType v, floaxie::chars_format fmt, bool plain)
+	{
+		return plain ? floaxie::to_chars(first, last, v) : floaxie::to_chars(first, last, v, fmt);
+	}
+
+#ifdef FLOAXIE_TEST_STD_TO_CHARS
+	template<typename FloatType> string std_print(FloatType v, floaxie::chars_format fmt, bool plain)
+	{
+		char buffer[512];
+
+		const std::chars_format std_fmt(fmt == floaxie::chars_format::scientific ? std::chars_format::scientific :
+			fmt == floaxie::chars_format::fixed ? std::chars_format::fixed : std::chars_format::general);
+
+		const auto result = plain ? std::to_chars(buffer, buffer + sizeof(buffer), v) : std::to_chars(buffer, buffer + sizeof(buffer), v, std_fmt);
+		return string(buffer, result.ptr);
+	}
+#endif
+
+	template<typename FloatType> bool check_std(FloatType v, floaxie::chars_format fmt, bool plain)
+	{
+#ifdef FLOAXIE_TEST_STD_TO_CHARS
+		char buffer[512];
+		const auto result = print(buffer, buffer + sizeof(buffer), v, fmt, plain);
+		const string expected(std_print(v, fmt, plain));
+
+		if (result.ec != errc() || string(buffer, result.ptr) != expected)
+		{
+			cerr << v << " is printed as " << string(buffer, result.ptr) << " instead of " << expected << " by std::to_chars()" << endl;
+			return false;
+		}
+#else
+		static_cast<void>(v);
+		static_cast<void>(fmt);
+		static_cast<void>(plain);
+#endif
+
+		return true;
+	}
+
+	bool check(double v, floaxie::chars_format fmt, bool plain = false)
+	{
+		char buffer[512];
+		memset(buffer, sentinel, sizeof(buffer));
+
+		const auto result = print(buffer, buffer + sizeof(buffer), v, fmt, plain);
+		if (result.ec != errc())
+		{
+			cerr << "failed to print " << v << endl;
+			return false;
+		}
+
+		const size_t length(result.ptr - buffer);
+		if (buffer[length] != sentinel)
+		{
+			cerr << "representation of " << v << " is followed by extra characters" << endl;
+			return false;
+		}
+
+		const string str(buffer, length);
+		if (strtod(str.c_str(), nullptr) != v || std::signbit(strtod(str.c_str(), nullptr)) != std::signbit(v))
+		{
+			cerr << v << " is printed as " << str << endl;
+			return false;
+		}
+
+		const bool has_exponent(str.find('e') != string::npos);
+		if (!plain && ((fmt == floaxie::chars_format::fixed && has_exponent) || (fmt == floaxie::chars_format::scientific && !has_exponent)))
+		{
+			cerr << v << " is printed in wrong format: " << str << endl;
+			return false;
+		}
+
+		if (!check_std(v, fmt, plain) || !check_std(float(v), fmt, plain))
+			return false;
+
+		// exact and too small ranges, both big and small enough for in-place generation
+		char* const tail(buffer + sizeof(buffer) - length);
+		memset(buffer, sentinel, sizeof(buffer));
+
+		const auto exact = print(tail, buffer + sizeof(buffer), v, fmt, plain);
+		if (exact.ec != errc() || exact.ptr != buffer + sizeof(buffer) || string(tail, length) != str)
+		{
+			cerr << "failed to print " << v << " to range of exact size" << endl;
+			return false;
+		}
+
+		memset(buffer, sentinel, sizeof(buffer));
+
+		const auto too_small = print(tail + 1, buffer + sizeof(buffer), v, fmt, plain);
+		if (too_small.ec != errc::value_too_large || too_small.ptr != buffer + sizeof(buffer) || *tail != sentinel)
+		{
+			cerr << "printing of " << v << " to too small range is not detected" << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	struct representation
+	{
+		double value;
+		floaxie::chars_format fmt;
+		bool plain;
+		const char* expected;
+	};
+
+	const auto general(floaxie::chars_format::general), scientific(floaxie::chars_format::scientific), fixed(floaxie::chars_format::fixed);
+
+	// the same, as std::to_chars() prints
+	const representation representations[] =
+	{
+		{ -0., general, true, "-0" }, { -0., scientific, false, "-0e+00" }, { 0., scientific, false, "0e+00" }, { -0., fixed, false, "-0" },
+		{ 1e16, scientific, false, "1e+16" }, { 1e16, general, false, "1e+16" }, { 1e16, general, true, "1e+16" },
+		{ 100., general, false, "100" }, { 1e6, general, false, "1e+06" }, { 123456., general, false, "123456" },
+		{ 123456789., general, false, "1.23456789e+08" }, { 123456789., general, true, "123456789" }, { 1e5, general, false, "100000" },
+		{ 1e-7, scientific, false, "1e-07" }, { 0.0001, general, false, "0.0001" }, { 0.00001, general, false, "1e-05" },
+		{ 1.5e-300, scientific, false, "1.5e-300" }, { 12345., general, true, "12345" }, { 1e5, general, true, "1e+05" },
+		{ -numeric_limits<double>::quiet_NaN(), general, true, "-nan" }, { numeric_limits<double>::quiet_NaN(), fixed, false, "nan" }
+	};
+
+	for (const auto& r : representations)
+	{
+		char buffer[64];
+		const auto result = print(buffer, buffer + sizeof(buffer), r.value, r.fmt, r.plain);
+
+		if (result.ec != errc() || string(buffer, result.ptr) != r.expected)
+		{
+			cerr << r.expected << " is printed as " << string(buffer, result.ptr) << endl;
+			return -5;
+		}
+	}
+
+	const double values[] = { 0.1, -0.1, 1, 100, 123.456, 1e21, 1e-7, -1.5e300, 5e-324, 1.7976931348623157e308, 0, -0., 0.30000000000000004, 1e16, 1e15 };
+	const floaxie::chars_format formats[] = { floaxie::chars_format::general, floaxie::chars_format::fixed, floaxie::chars_format::scientific };
+
+	for (auto v : values)
+	{
+		if (!check(v, floaxie::chars_format::general, true))
+			return -1;
+	}
+
+	for (auto fmt : formats)
+	{
+		for (auto v : values)
+		{
+			if (!check(v, fmt))
+				return -1;
+		}
+
+		default_random_engine gen(1);
+		uniform_int_distribution<int> exp_dis(-300, 300);
+		uniform_real_distribution<double> dis(-1, 1);
+
+		for (size_t i = 0; i < 10000; ++i)
+		{
+			const double v(dis(gen) * pow(10, exp_dis(gen)));
+			if (!check(v, fmt) || !check(v, fmt, true))
+				return -2;
+		}
+	}
+
+	wchar_t wbuffer[16];
+	const auto result = floaxie::to_chars(wbuffer, wbuffer + 3, 0.5);
+	if (result.ec != errc() || result.ptr != wbuffer + 3 || wstring(wbuffer, 3) != L"0.5")
+		return -3;
+
+	const auto special = floaxie::to_chars(wbuffer, wbuffer + 3, -numeric_limits<double>::infinity());
+	if (special.ec != errc::value_too_large)
+		return -4;
+
+	return 0;
+}
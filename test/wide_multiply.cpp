@@ -0,0 +1,79 @@
+#include <iostream>
+#include <random>
+#include <cstdint>
+
+#include "floaxie/wide_multiply.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	// the original diy_fp multiplication by means of halves of the operands
+	template<typename NumericType> NumericType reference_multiply(NumericType lhs, NumericType rhs)
+	{
+		constexpr size_t half_width(sizeof(NumericType) * 4);
+		constexpr NumericType mask_half((NumericType(1) << half_width) - 1);
+
+		const NumericType a(lhs >> half_width), b(lhs & mask_half);
+		const NumericType c(rhs >> half_width), d(rhs & mask_half);
+
+		const NumericType ac(a * c), bc(b * c), ad(a * d), bd(b * d);
+
+		const NumericType tmp((bd >> half_width) + (ad & mask_half) + (bc & mask_half) + (NumericType(1) << (half_width - 1)));
+
+		return ac + (ad >> half_width) + (bc >> half_width) + (tmp >> half_width);
+	}
+
+	bool check(uint64_t lhs, uint64_t rhs)
+	{
+		const wide_product product(full_multiply(lhs, rhs));
+		const wide_product portable_product(portable_full_multiply(lhs, rhs));
+
+		if (product.high != portable_product.high || product.low != portable_product.low)
+		{
+			cerr << "full product of " << lhs << " and " << rhs << " differs from portable one" << endl;
+			return false;
+		}
+
+		if (rounded_multiply_high(lhs, rhs) != reference_multiply(lhs, rhs))
+		{
+			cerr << "rounded product of " << lhs << " and " << rhs << " is wrong" << endl;
+			return false;
+		}
+
+		const uint32_t lhs32(lhs >> 32), rhs32(rhs & 0xffffffff);
+
+		if (rounded_multiply_high(lhs32, rhs32) != reference_multiply(lhs32, rhs32))
+		{
+			cerr << "rounded product of " << lhs32 << " and " << rhs32 << " is wrong" << endl;
+			return false;
+		}
+
+		return true;
+	}
+}
+
+int main(int, char**)
+{
+	const uint64_t edge_values[] = { 0, 1, 0xffffffff, 0x100000000, 0x8000000000000000, 0xffffffffffffffff, 0xcccccccccccccccd };
+
+	for (auto lhs : edge_values)
+	{
+		for (auto rhs : edge_values)
+		{
+			if (!check(lhs, rhs))
+				return -1;
+		}
+	}
+
+	mt19937_64 gen(1);
+
+	for (size_t i = 0; i < 1000000; ++i)
+	{
+		if (!check(gen(), gen()))
+			return -2;
+	}
+
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include <array>
+#include <new>
+#include <cstdlib>
+#include <cstddef>
+#include <iostream>
+
+#include "floaxie/atof.h"
+
+using namespace std;
+using namespace floaxie;
+
+namespace
+{
+	size_t allocation_count(0);
+
+	const array<const char*, 12> test_chain {{
+		"0",
+		"0.5",
+		"-123.45",
+		"0.001",
+		"18014398509481993",
+		"3.14159265358979323846264",
+		"0000123400.05678900000",
+		"1.2345689012e37",
+		"675698e-312",
+		"3.50582559e-71",
+		"-inf",
+		"nan(123)"
+	}};
+}
+
+void* operator new(size_t size)
+{
+	++allocation_count;
+
+	if (void* p = malloc(size))
+		return p;
+
+	throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+	free(p);
+}
+
+int main(int, char**)
+{
+	char* str_end;
+	size_t fallback_count(0);
+	auto fallback_lambda = [&fallback_count](const char* str, char** str_end)
+	{
+		++fallback_count;
+		return default_fallback<double>(str, str_end);
+	};
+
+	const size_t allocations_before(allocation_count);
+
+	for (const auto str : test_chain)
+	{
+		atof<double>(str, &str_end, fallback_lambda);
+		atof<float>(str, &str_end);
+	}
+
+	const size_t allocations_made(allocation_count - allocations_before);
+
+	cout << allocations_made << " allocations made for " << test_chain.size() << " values, fallback was called " << fallback_count << " times" << endl;
+
+	if (fallback_count)
+		return -1;
+
+	if (allocations_made)
+		return -2;
+
+	return 0;
+}